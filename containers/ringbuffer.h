@@ -168,6 +168,28 @@ static void PRE(RinBuf_sort) (PRE(RinBuf) *r) {
     r->head_pointer = r->size-1;
     PRE(RinBuf_sort_range) (r->buffer, 0, r->size-1);
 }
+
+// Inserts an item keeping the ring sorted (as left by RinBuf_sort), the
+// smallest item is evicted. Cheaper than push + sort for nearly sorted input.
+// Items already present or smaller than all items are discarded.
+// @returns 0 if inserted
+static int PRE(RinBuf_insert_sorted) (PRE(RinBuf) *r, TYPE item) {
+    if (r->size == 0) return -1;
+    r->head_pointer = r->size-1;
+
+    // look from the top, new items are usually the greatest
+    size_t pos = r->size-1;
+    while (pos > 0 && item < r->buffer[pos]) {
+        --pos;
+    }
+    if (item < r->buffer[pos] || !(r->buffer[pos] < item)) {
+        return -1;
+    }
+
+    memmove(&r->buffer[0], &r->buffer[1], pos * sizeof(TYPE));
+    r->buffer[pos] = item;
+    return OK;
+}
 #endif // !RINGBUFFER_ENABLE_SORT
 
 #undef TYPE
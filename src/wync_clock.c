@@ -44,6 +44,8 @@ void WyncClock_client_handle_pkt_clock (WyncCtx *ctx, WyncPktClock pkt) {
 
 	printf("LATENCIA REAL %f\n", curr_time - (double)pkt.time_og);
 
+	WyncStat_client_clock_response_received(ctx);
+
 	// calculate mean
 	// Note: To improve accurace modify _server clock sync_ throttling or
 	// sliding window size
@@ -267,6 +269,8 @@ i32 WyncClock_client_ask_for_clock(WyncCtx *ctx, bool force) {
 			UNRELIABLE,
 			false
 		);
+
+		WyncStat_client_clock_request_sent(ctx);
 		
 	} while (0);
 
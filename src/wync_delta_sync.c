@@ -197,21 +197,16 @@ int WyncDelta_merge_event_to_state_real_state (
 // TODO: Make a separate version for only "clear_events_nonpredicted_owned_events"
 // So that it doens't interfere with Xtrap tick end
 void WyncDelta_predicted_event_props_clear_events (WyncCtx *ctx) {
-	WyncWrapper_Setter *setter;
-	WyncWrapper_UserCtx *user_ctx;
 	u32_DynArrIterator it = { 0 };
 	WyncWrapper_Data event_list_zeroed_blob = WyncEventUtil_event_get_zeroed();
+	WyncState event_list_zeroed = (WyncState) {
+		event_list_zeroed_blob.data_size, event_list_zeroed_blob.data };
 
 	while (u32_DynArr_iterator_get_next(
 		&ctx->co_filter_c.type_event__predicted_prop_ids, &it) == OK)
 	{
 		uint prop_id = *it.item;
-
-		setter = &ctx->wrapper->prop_setter[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-		if (*setter == NULL) continue;
-
-		(*setter)(*user_ctx, event_list_zeroed_blob);
+		WyncWrapper_set_prop_state(ctx, prop_id, event_list_zeroed);
 	}
 
 	// TODO: Index prop_ids which are owned of event type
@@ -224,31 +219,26 @@ void WyncDelta_predicted_event_props_clear_events (WyncCtx *ctx) {
 		if (prop == NULL) continue;
 		if (prop->prop_type != WYNC_PROP_TYPE_EVENT) continue;
 
-		setter = &ctx->wrapper->prop_setter[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-		if (*setter == NULL) continue;
-
-		(*setter)(*user_ctx, event_list_zeroed_blob);
+		WyncWrapper_set_prop_state(ctx, prop_id, event_list_zeroed);
 	}
+
+	WyncWrapper_flush_batch_setters(ctx);
 }
 // TODO: rename
 void WyncXtrap_delta_props_clear_current_delta_events (WyncCtx *ctx) {
-	WyncWrapper_Setter *setter;
-	WyncWrapper_UserCtx *user_ctx;
 	u32_DynArrIterator it = { 0 };
 	WyncWrapper_Data event_list_zeroed_blob = WyncEventUtil_event_get_zeroed();
+	WyncState event_list_zeroed = (WyncState) {
+		event_list_zeroed_blob.data_size, event_list_zeroed_blob.data };
 
 	while (u32_DynArr_iterator_get_next(
 		&ctx->co_filter_c.type_state__delta_prop_ids, &it) == OK)
 	{
 		uint prop_id = *it.item;
-
-		setter = &ctx->wrapper->prop_setter[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-		if (*setter == NULL) continue;
-
-		(*setter)(*user_ctx, event_list_zeroed_blob);
+		WyncWrapper_set_prop_state(ctx, prop_id, event_list_zeroed);
 	}
+
+	WyncWrapper_flush_batch_setters(ctx);
 }
 
 
@@ -48,6 +48,7 @@ static void WyncFlow_internal_setup_context(WyncCtx *ctx) {
 
 	wync_init_ctx_throttling(ctx);
 	wync_init_ctx_filter_s(ctx);
+	wync_init_ctx_timewarp(ctx);
 
 	wync_init_ctx_ticks(ctx);
 	wync_init_ctx_prediction_data(ctx);
@@ -367,6 +368,7 @@ void WyncFlow_server_tick_end(WyncCtx *ctx) {
 	// We need a function to extract data exclusively of events... Like the equivalent
 	// of the client's _input_bufferer_
 	WyncWrapper_extract_data_to_tick(ctx, ctx->common.ticks); // wrapper function
+	WyncTimewarp_record_history(ctx, (i32)ctx->common.ticks);
 }
 
 void WyncFlow_client_tick_end(WyncCtx *ctx) {
@@ -392,6 +394,7 @@ void WyncFlow_client_tick_end(WyncCtx *ctx) {
 
 	WyncStore_service_cleanup_dummy_props(ctx);
 
+	WyncLerp_client_adapt_lerp_ms(ctx);
 	WyncLerp_precompute(ctx);
 }
 
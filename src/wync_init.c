@@ -37,6 +37,10 @@ void wync_init_ctx_state_tracking(WyncCtx *ctx) {
 
 	ConMap_init(&co_track->tracked_entities);
 	co_track->props = (WyncProp*) calloc (sizeof(WyncProp), MAX_PROPS);
+	co_track->prop_flags = (u16*) calloc (sizeof(u16), MAX_PROPS);
+	co_track->prop_type = (u8*) calloc (sizeof(u8), MAX_PROPS);
+	co_track->prop_entity_id = (u32*) malloc (sizeof(u32) * MAX_PROPS);
+	memset(co_track->prop_entity_id, 0xFF, sizeof(u32) * MAX_PROPS);
 	ConMap_init(&co_track->active_prop_ids);
 	u32_DynArr_ConMap_init(&co_track->entity_has_props);
 	ConMap_init(&co_track->entity_is_of_type);
@@ -119,6 +123,7 @@ void wync_init_ctx_metrics(WyncCtx *ctx) {
 	co_metrics->debug_data_per_tick_sliding_window_size = 8;
 	co_metrics->low_priority_entity_update_rate_sliding_window_size = 8;
 	co_metrics->PROP_ID_PROB = -1;
+	co_metrics->input_amount_to_send = INPUT_AMOUNT_TO_SEND;
 
 	co_metrics->debug_data_per_tick_sliding_window = u32_RinBuf_create
 		(co_metrics->debug_data_per_tick_sliding_window_size, 0);
@@ -220,6 +225,12 @@ void wync_init_ctx_prediction_data(WyncCtx *ctx) {
 	ConMap_init(&co_pred->entity_last_predicted_tick);
 	ConMap_init(&co_pred->entity_last_received_tick);
 	co_pred->predicted_entity_ids = u32_DynArr_create();
+	ConMap_init(&co_pred->predicted_entity_index);
+	co_pred->predicted_xtrap_prop_ids = u32_DynArr_create();
+	co_pred->predicted_xtrap_prop_offsets = u32_DynArr_create();
+	co_pred->predicted_received_prop_ids = u32_DynArr_create();
+	co_pred->predicted_received_prop_offsets = u32_DynArr_create();
+	co_pred->diverged_entity_ids = u32_DynArr_create();
 
 	co_pred->first_tick_predicted = 1;
 	co_pred->last_tick_predicted = 0;
@@ -239,6 +250,8 @@ void wync_init_ctx_lerp(WyncCtx *ctx) {
 	ctx->co_lerp.lerp_ms = 50;
 	ctx->co_lerp.lerp_latency_ms = 0;
 	ctx->co_lerp.max_lerp_factor_symmetric = 1.0;
+	ctx->co_lerp.extrapolation_max_ms = 0;
+	ctx->co_lerp.extrapolation_correction_ms = 0;
 }
 
 
@@ -260,6 +273,13 @@ void wync_init_ctx_filter_s(WyncCtx *ctx) {
 }
 
 
+void wync_init_ctx_timewarp(WyncCtx *ctx) {
+	CoTimewarp *co_timewarp = &ctx->co_timewarp;
+	co_timewarp->dirty_entity_ids = u32_DynArr_create();
+	co_timewarp->restore_prop_ids = u32_DynArr_create();
+}
+
+
 void wync_init_ctx_filter_c(WyncCtx *ctx) {
 	CoFilterClient *filter = &ctx->co_filter_c;
 	filter->type_input_event__owned_prop_ids = u32_DynArr_create();
@@ -270,4 +290,5 @@ void wync_init_ctx_filter_c(WyncCtx *ctx) {
 	filter->type_state__predicted_regular_prop_ids = u32_DynArr_create();
 	filter->type_state__interpolated_regular_prop_ids = u32_DynArr_create();
 	filter->type_state__newstate_prop_ids = u32_DynArr_create();
+	filter->type_state__rollback_prop_ids = u32_DynArr_create();
 }
@@ -140,6 +140,7 @@ i32 WyncJoin_service_wync_try_to_connect(WyncCtx *ctx) {
 
 	WyncPktClientSetLerpMS packet_lerp = { 0 };
 	packet_lerp.lerp_ms = ctx->co_lerp.lerp_ms;
+	ctx->co_lerp.lerp_ms_sent = ctx->co_lerp.lerp_ms;
 
 	WyncPacket_wrap_and_queue(
 		ctx,
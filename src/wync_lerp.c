@@ -53,11 +53,11 @@ static struct LerpTicks WyncLerp_find_closest_two_snapshots_from_prop (
 			continue;
 		}
 
-		// This check is necessary because of the current strategy where we sort
-		// last_ticks_received causing newer received ticks (albeit older
-		// numerically) to overlive older received ticks with higher number
+		// This check is necessary because last_ticks_received keeps the
+		// numerically highest ticks, their state might have been replaced
+		// already by newer arrivals (albeit older numerically)
 		WyncState data =
-			WyncState_prop_state_buffer_get_throughout(prop, server_tick);
+			WyncState_prop_state_buffer_get(prop, server_tick);
 		if (data.data_size == 0 || data.data == NULL) {
 			continue;
 		}
@@ -113,6 +113,104 @@ static struct LerpTicks WyncLerp_find_closest_two_snapshots_from_prop (
 }
 
 
+/// @returns Closest tick received before (or after) 'tick' that still has
+/// it's state, -1 if none
+static i32 WyncLerp_find_neighbor_tick (WyncProp *prop, i32 tick, bool after) {
+	i32_RinBuf *ticks = &prop->statebff.last_ticks_received;
+	i32 best = -1;
+
+	for (size_t i = 0; i < ticks->size; ++i) {
+		i32 other = ticks->buffer[i];
+		if (other == -1 || (after ? other <= tick : other >= tick)) {
+			continue;
+		}
+		if (best != -1 && (after ? other >= best : other <= best)) {
+			continue;
+		}
+		if (WyncState_prop_state_buffer_get(prop, other).data == NULL) {
+			continue;
+		}
+		best = other;
+	}
+	return best;
+}
+
+
+/// Precomputes the tangents of cubic lerp props for their current pair
+static void WyncLerp_precompute_tangents (WyncCtx *ctx, WyncProp *prop) {
+	WyncProp_Lerp *lerp = &prop->co_lerp;
+	lerp->lerp_tangents_ready = false;
+	if (lerp->lerp_mode == WYNC_LERP_MODE_LINEAR) {
+		return;
+	}
+
+	u32 size = lerp->lerp_left_state.data_size;
+	if (size == 0 || size % sizeof(float) != 0
+		|| size != lerp->lerp_right_state.data_size) {
+		return;
+	}
+	u32 amount = size / sizeof(float);
+	i32 tick_left = lerp->lerp_left_canon_tick;
+	i32 tick_right = lerp->lerp_right_canon_tick;
+	float interval = (float)(tick_right - tick_left);
+
+	const float *p1 = lerp->lerp_left_state.data;
+	const float *p2 = lerp->lerp_right_state.data;
+	const float *v1 = NULL, *v2 = NULL, *p0 = NULL, *p3 = NULL;
+	i32 tick_prev = -1, tick_next = -1;
+
+	if (lerp->lerp_mode == WYNC_LERP_MODE_HERMITE) {
+		WyncProp *vel_prop = WyncTrack_get_prop(ctx, lerp->lerp_velocity_prop_id);
+		if (vel_prop == NULL) {
+			return;
+		}
+		WyncState vel_left = WyncState_prop_state_buffer_get(vel_prop, tick_left);
+		WyncState vel_right = WyncState_prop_state_buffer_get(vel_prop, tick_right);
+		if (vel_left.data_size != size || vel_right.data_size != size) {
+			return;
+		}
+		v1 = vel_left.data;
+		v2 = vel_right.data;
+	}
+	else {
+		tick_prev = WyncLerp_find_neighbor_tick(prop, tick_left, false);
+		tick_next = WyncLerp_find_neighbor_tick(prop, tick_right, true);
+		WyncState prev = WyncState_prop_state_buffer_get(prop, tick_prev);
+		WyncState next = WyncState_prop_state_buffer_get(prop, tick_next);
+		if (prev.data_size == size) p0 = prev.data;
+		if (next.data_size == size) p3 = next.data;
+	}
+
+	if (lerp->lerp_tangents.data_size != size * 2) {
+		WyncState_free(&lerp->lerp_tangents);
+		lerp->lerp_tangents.data = calloc(2, size);
+		lerp->lerp_tangents.data_size = size * 2;
+	}
+	float *m1 = lerp->lerp_tangents.data;
+	float *m2 = m1 + amount;
+
+	if (v1 != NULL) {
+		float interval_s =
+			interval / (float)ctx->common.physic_ticks_per_second;
+		for (u32 i = 0; i < amount; ++i) {
+			m1[i] = v1[i] * interval_s;
+			m2[i] = v2[i] * interval_s;
+		}
+	}
+	else {
+		// non uniform catmull-rom, missing neighbors mirror the pair
+
+		float scale_prev = p0 ? interval / (float)(tick_right - tick_prev) : 1;
+		float scale_next = p3 ? interval / (float)(tick_next - tick_left) : 1;
+		for (u32 i = 0; i < amount; ++i) {
+			m1[i] = ((p0 ? p2[i] - p0[i] : p2[i] - p1[i])) * scale_prev;
+			m2[i] = ((p3 ? p3[i] - p1[i] : p2[i] - p1[i])) * scale_next;
+		}
+	}
+	lerp->lerp_tangents_ready = true;
+}
+
+
 static void WyncLerp_precompute_confirmed_states (
 	WyncCtx *ctx,
 	WyncProp *prop,
@@ -120,17 +218,35 @@ static void WyncLerp_precompute_confirmed_states (
 ) {
 	struct LerpTicks snaps = WyncLerp_find_closest_two_snapshots_from_prop(
 		ctx, prop, target_time_ms);
+
+	// until new state arrives nothing changes, unless the target time
+	// passes the right snapshot
+
+	prop->co_lerp.lerp_next_boundary_ms = INFINITY;
 	if (snaps.lhs_tick_server == -1) {
 		return;
 	}
+	float rhs_timestamp_ms =
+		WyncClock_get_tick_timestamp_ms(ctx, snaps.rhs_tick_local);
+	if (rhs_timestamp_ms > target_time_ms) {
+		prop->co_lerp.lerp_next_boundary_ms = rhs_timestamp_ms;
+	}
 
 	if (prop->co_lerp.lerp_left_canon_tick == snaps.lhs_tick_server
 		&& prop->co_lerp.lerp_right_canon_tick == snaps.rhs_tick_server
 	) {
+		// neighbor snapshots might have arrived
+		if (prop->co_lerp.lerp_ready) {
+			WyncLerp_precompute_tangents(ctx, prop);
+		}
 		return;
 	}
 
 	prop->co_lerp.lerp_ready = false;
+	if (prop->co_lerp.lerp_extrapolating) {
+		prop->co_lerp.lerp_extrapolating = false;
+		prop->co_lerp.lerp_correction_pending = true;
+	}
 	prop->co_lerp.lerp_left_canon_tick = snaps.lhs_tick_server;
 	prop->co_lerp.lerp_right_canon_tick = snaps.rhs_tick_server;
 	prop->co_lerp.lerp_left_local_tick =
@@ -146,9 +262,9 @@ static void WyncLerp_precompute_confirmed_states (
 		ctx->co_ticks.last_tick_rendered_left,
 		prop->co_lerp.lerp_left_canon_tick);
 
-	WyncState val_left = WyncState_prop_state_buffer_get_throughout(
+	WyncState val_left = WyncState_prop_state_buffer_get(
 		prop, prop->co_lerp.lerp_left_canon_tick);
-	WyncState val_right = WyncState_prop_state_buffer_get_throughout(
+	WyncState val_right = WyncState_prop_state_buffer_get(
 		prop, prop->co_lerp.lerp_right_canon_tick);
 
 	if (val_left.data_size == 0 || val_left.data == NULL 
@@ -165,6 +281,8 @@ static void WyncLerp_precompute_confirmed_states (
 		&prop->co_lerp.lerp_left_state, val_left.data_size, val_left.data);
 	WyncState_set_from_buffer(
 		&prop->co_lerp.lerp_right_state, val_left.data_size, val_right.data);
+
+	WyncLerp_precompute_tangents(ctx, prop);
 }
 
 
@@ -204,7 +322,10 @@ void WyncLerp_client_set_lerp_ms(
 	float server_tick_rate,
 	u32 lerp_ms
 ) {
-	ctx->co_lerp.lerp_ms = MAX(lerp_ms, ceil((1000.0 / server_tick_rate) * 2));
+	// with dead reckoning one update interval suffices
+	u32 min_updates = ctx->co_lerp.extrapolation_max_ms > 0 ? 1 : 2;
+	ctx->co_lerp.lerp_ms =
+		MAX(lerp_ms, ceil((1000.0 / server_tick_rate) * min_updates));
 
 	// TODO: Also set maximum based on tick history size
 	// Note: What about tick differences between server and clients?
@@ -212,6 +333,509 @@ void WyncLerp_client_set_lerp_ms(
 
 
 
+/// Standard deviation of the snapshot delay in ms
+static float WyncLerp_measure_jitter_ms (WyncCtx *ctx) {
+	u32_RinBuf *window = &ctx->co_metrics.snap_tick_delay_window;
+	float frame = 1000.0 / ctx->common.physic_ticks_per_second;
+	float sum = 0;
+	float sum_sq = 0;
+	u32 amount = 0;
+
+	for (size_t i = 0; i < window->size; ++i) {
+		u32 value = *u32_RinBuf_get_absolute(window, i);
+		if (value == 0 || value > INT16_MAX) continue; // empty or negative
+		sum += (float)value;
+		sum_sq += (float)value * (float)value;
+		++amount;
+	}
+	if (amount < 2) {
+		return 0;
+	}
+	float mean = sum / amount;
+	float variance = MAX(sum_sq / amount - mean * mean, 0.f);
+	return sqrtf(variance) * frame;
+}
+
+
+/// Client only. Grows lerp_ms by the jitter while the interpolation keeps
+/// running out of snapshots, otherwise shrinks it slowly.
+void WyncLerp_client_adapt_lerp_ms (WyncCtx *ctx) {
+	CoLerp *co_lerp = &ctx->co_lerp;
+	if (!co_lerp->adaptive_enabled || !ctx->common.connected) {
+		return;
+	}
+
+	// underrun: the interpolation target is past the newest snapshot
+
+	float curr_time = WyncClock_get_tick_timestamp_ms(ctx, ctx->common.ticks);
+	float target_time = curr_time - co_lerp->lerp_ms - co_lerp->lerp_latency_ms;
+	float newest_time = WyncClock_get_tick_timestamp_ms(ctx,
+		ctx->co_pred.last_tick_received - ctx->co_ticks.server_tick_offset);
+	if (target_time > newest_time) {
+		++co_lerp->adaptive_window_underruns;
+	}
+	if (++co_lerp->adaptive_window_ticks < LERP_ADAPTIVE_WINDOW_TICKS) {
+		return;
+	}
+
+	float frame = 1000.0 / ctx->common.physic_ticks_per_second;
+	float jitter_ms = WyncLerp_measure_jitter_ms(ctx);
+	float underrun_rate = (float)co_lerp->adaptive_window_underruns
+		/ (float)co_lerp->adaptive_window_ticks;
+	co_lerp->adaptive_window_ticks = 0;
+	co_lerp->adaptive_window_underruns = 0;
+
+	float lerp_ms = co_lerp->lerp_ms;
+	if (underrun_rate > co_lerp->adaptive_underrun_target) {
+		lerp_ms += MAX(frame, 2 * jitter_ms);
+	}
+	else if (underrun_rate <= co_lerp->adaptive_underrun_target / 2) {
+		// step down a quarter of the margin over the jitter, at least 1 ms
+		float margin = lerp_ms - (frame + 2 * jitter_ms);
+		lerp_ms -= MAX(margin / 4, 1.f);
+	}
+	lerp_ms = MAX(MIN(lerp_ms, co_lerp->adaptive_max_ms),
+		co_lerp->adaptive_min_ms);
+	co_lerp->lerp_ms = (u16)ceilf(lerp_ms);
+
+	if (co_lerp->lerp_ms == co_lerp->lerp_ms_sent) {
+		return;
+	}
+
+	WyncPktClientSetLerpMS packet_lerp = { 0 };
+	packet_lerp.lerp_ms = co_lerp->lerp_ms;
+	i32 err = WyncPacket_wrap_and_queue(ctx, WYNC_PKT_CLIENT_SET_LERP_MS,
+		&packet_lerp, SERVER_PEER_ID, RELIABLE, true);
+	if (err == OK) {
+		co_lerp->lerp_ms_sent = co_lerp->lerp_ms;
+	}
+}
+
+
+
+// ==================================================
+// Built-in kernels
+// ==================================================
+
+// Plain loops over restrict pointers, compilers vectorize them to SSE/NEON
+
+static void WyncLerp_kernel_f32 (
+	const float *restrict a,
+	const float *restrict b,
+	float *restrict out,
+	u32 amount,
+	float t
+) {
+	for (u32 i = 0; i < amount; ++i) {
+		out[i] = a[i] + (b[i] - a[i]) * t;
+	}
+}
+
+
+static void WyncLerp_kernel_i32 (
+	const i32 *restrict a,
+	const i32 *restrict b,
+	i32 *restrict out,
+	u32 amount,
+	float t
+) {
+	for (u32 i = 0; i < amount; ++i) {
+		float from = (float)a[i];
+		out[i] = (i32)floorf(from + ((float)b[i] - from) * t + 0.5f);
+	}
+}
+
+
+/// Takes the shortest arc, falls back to nlerp when the quaternions are too
+/// close for slerp to be stable
+static void WyncLerp_kernel_quat (
+	const float *restrict a,
+	const float *restrict b,
+	float *restrict out,
+	u32 amount,
+	float t,
+	bool slerp
+) {
+	for (u32 q = 0; q < amount; ++q) {
+		const float *qa = a + q * 4;
+		const float *qb = b + q * 4;
+		float *qo = out + q * 4;
+
+		float dot = qa[0]*qb[0] + qa[1]*qb[1] + qa[2]*qb[2] + qa[3]*qb[3];
+		float sign = dot < 0 ? -1.f : 1.f;
+		dot *= sign;
+
+		float wa = 1.f - t;
+		float wb = t * sign;
+		if (slerp && dot < 0.9995f) {
+			float theta = acosf(dot);
+			float sin_theta = sinf(theta);
+			wa = sinf((1.f - t) * theta) / sin_theta;
+			wb = sinf(t * theta) / sin_theta * sign;
+		}
+
+		float len_sq = 0;
+		for (u32 i = 0; i < 4; ++i) {
+			qo[i] = qa[i] * wa + qb[i] * wb;
+			len_sq += qo[i] * qo[i];
+		}
+		float inv_len = len_sq > 0 ? 1.f / sqrtf(len_sq) : 0;
+		for (u32 i = 0; i < 4; ++i) {
+			qo[i] *= inv_len;
+		}
+	}
+}
+
+
+/// Cubic hermite between p1 and p2 with tangents m1 and m2, beyond the
+/// interval it continues along the end tangent
+static void WyncLerp_kernel_hermite (
+	const float *restrict p1,
+	const float *restrict p2,
+	const float *restrict m1,
+	const float *restrict m2,
+	float *restrict out,
+	u32 amount,
+	float t
+) {
+	if (t < 0) {
+		for (u32 i = 0; i < amount; ++i) {
+			out[i] = p1[i] + m1[i] * t;
+		}
+		return;
+	}
+	if (t > 1) {
+		for (u32 i = 0; i < amount; ++i) {
+			out[i] = p2[i] + m2[i] * (t - 1);
+		}
+		return;
+	}
+
+	float t2 = t * t;
+	float t3 = t2 * t;
+	float h00 = 2*t3 - 3*t2 + 1;
+	float h10 = t3 - 2*t2 + t;
+	float h01 = -2*t3 + 3*t2;
+	float h11 = t3 - t2;
+	for (u32 i = 0; i < amount; ++i) {
+		out[i] = h00 * p1[i] + h10 * m1[i] + h01 * p2[i] + h11 * m2[i];
+	}
+}
+
+
+static bool WyncLerp_kernel_accepts_size (
+	enum WYNC_LERP_KERNEL kernel,
+	u32 size
+) {
+	switch (kernel) {
+		case WYNC_LERP_KERNEL_F32:
+			return size % sizeof(float) == 0;
+		case WYNC_LERP_KERNEL_I32:
+			return size % sizeof(i32) == 0;
+		case WYNC_LERP_KERNEL_QUAT_NLERP:
+		case WYNC_LERP_KERNEL_QUAT_SLERP:
+			return size % (sizeof(float) * 4) == 0;
+		default:
+			return false;
+	}
+}
+
+
+/// Doesn't validate, see WyncLerp_kernel_accepts_size
+static void WyncLerp_kernel_dispatch (
+	enum WYNC_LERP_KERNEL kernel,
+	const void *a,
+	const void *b,
+	void *out,
+	u32 size,
+	float t
+) {
+	switch (kernel) {
+		case WYNC_LERP_KERNEL_F32:
+			WyncLerp_kernel_f32(a, b, out, size / sizeof(float), t);
+			break;
+		case WYNC_LERP_KERNEL_I32:
+			WyncLerp_kernel_i32(a, b, out, size / sizeof(i32), t);
+			break;
+		case WYNC_LERP_KERNEL_QUAT_NLERP:
+		case WYNC_LERP_KERNEL_QUAT_SLERP:
+			WyncLerp_kernel_quat(a, b, out, size / (sizeof(float) * 4), t,
+				kernel == WYNC_LERP_KERNEL_QUAT_SLERP);
+			break;
+		default:
+			break;
+	}
+}
+
+
+/// @returns error
+i32 WyncLerp_run_kernel (
+	enum WYNC_LERP_KERNEL kernel,
+	WyncWrapper_Data from,
+	WyncWrapper_Data to,
+	float delta,
+	void *out
+) {
+	u32 size = from.data_size;
+	if (from.data == NULL || to.data == NULL || out == NULL
+		|| size == 0 || size != to.data_size) {
+		return -1;
+	}
+
+	if (!WyncLerp_kernel_accepts_size(kernel, size)) {
+		return -2;
+	}
+	WyncLerp_kernel_dispatch(kernel, from.data, to.data, out, size, delta);
+	return OK;
+}
+
+
+/// Without a 'setter' the prop's own or batch setter is used, batched props
+/// are set on WyncWrapper_flush_batch_setters
+static void WyncLerp_set (
+	WyncCtx *ctx,
+	u32 prop_id,
+	WyncWrapper_Setter setter,
+	WyncWrapper_UserCtx user_ctx,
+	WyncWrapper_Data data
+) {
+	if (setter != NULL) {
+		setter(user_ctx, data);
+		return;
+	}
+	WyncWrapper_set_prop_state_copy(
+		ctx, prop_id, (WyncState) { data.data_size, data.data });
+}
+
+
+/// Interpolates with the type's kernel or else it's lerp function, then
+/// hands the result to 'setter'
+///
+/// @returns error
+static i32 WyncLerp_lerp_and_set (
+	WyncCtx *ctx,
+	u32 prop_id,
+	u16 user_type_id,
+	WyncState left,
+	WyncState right,
+	float factor,
+	WyncWrapper_Setter setter,
+	WyncWrapper_UserCtx user_ctx
+) {
+	WyncWrapper_Data from = { left.data_size, left.data };
+	WyncWrapper_Data to = { right.data_size, right.data };
+	u8 kernel = ctx->wrapper->lerp_kernel[user_type_id];
+
+	if (kernel != WYNC_LERP_KERNEL_NONE) {
+		if (left.data_size > WYNC_GETTER_SCRATCH_SIZE) {
+			return -1;
+		}
+		void *out = ctx->wrapper->lerp_scratch;
+		if (WyncLerp_run_kernel(kernel, from, to, factor, out) != OK) {
+			return -2;
+		}
+		WyncLerp_set(ctx, prop_id, setter, user_ctx,
+			(WyncWrapper_Data) { left.data_size, out });
+		return OK;
+	}
+
+	WyncWrapper_LerpFunc lerp_func = ctx->wrapper->lerp_function[user_type_id];
+	if (lerp_func == NULL) {
+		return -3;
+	}
+
+	WyncWrapper_Data lerped_state = lerp_func(from, to, factor);
+	WyncLerp_set(ctx, prop_id, setter, user_ctx, lerped_state);
+
+	WyncState lerped_state_to_free =
+		(WyncState) {lerped_state.data_size, lerped_state.data};
+	WyncState_free(&lerped_state_to_free);
+	return OK;
+}
+
+
+// ==================================================
+// Batches
+// ==================================================
+
+static void WyncLerp_batch_reserve (
+	WyncWrapper_LerpBatch *batch,
+	u32 amount,
+	u32 stride
+) {
+	if (amount > batch->capacity) {
+		u32 capacity = MAX(amount, batch->capacity * 2);
+		batch->factors = (float*) realloc(
+			batch->factors, sizeof(float) * capacity);
+		batch->user_ctxs = (WyncWrapper_UserCtx*) realloc(
+			batch->user_ctxs, sizeof(WyncWrapper_UserCtx) * capacity);
+		batch->datas = (WyncWrapper_Data*) realloc(
+			batch->datas, sizeof(WyncWrapper_Data) * capacity);
+		batch->capacity = capacity;
+	}
+
+	u32 bytes = batch->capacity * stride;
+	if (bytes > batch->bytes_capacity) {
+		batch->lefts = (char*) realloc(batch->lefts, bytes);
+		batch->rights = (char*) realloc(batch->rights, bytes);
+		batch->outs = (char*) realloc(batch->outs, bytes);
+		batch->bytes_capacity = bytes;
+	}
+}
+
+
+/// Queues the prop into it's type's batch if it has kernel and batch setter
+/// @returns whether it was queued
+static bool WyncLerp_batch_try_push (
+	WyncCtx *ctx,
+	u16 user_type_id,
+	WyncState left,
+	WyncState right,
+	float factor,
+	WyncWrapper_UserCtx user_ctx
+) {
+	WyncWrapperCtx *wrapper = ctx->wrapper;
+	WyncWrapper_LerpBatch *batch = &wrapper->lerp_batches[user_type_id];
+	u8 kernel = wrapper->lerp_kernel[user_type_id];
+	u32 size = left.data_size;
+
+	if (batch->setter == NULL || kernel == WYNC_LERP_KERNEL_NONE
+		|| size != right.data_size
+		|| !WyncLerp_kernel_accepts_size(kernel, size)) {
+		return false;
+	}
+
+	if (batch->amount == 0) {
+		batch->stride = size;
+		wrapper->lerp_batch_pending_types
+			[wrapper->lerp_batch_pending_amount++] = user_type_id;
+	}
+	else if (batch->stride != size) {
+		return false;
+	}
+
+	WyncLerp_batch_reserve(batch, batch->amount +1, size);
+
+	size_t offset = (size_t)batch->amount * size;
+	memcpy(batch->lefts + offset, left.data, size);
+	memcpy(batch->rights + offset, right.data, size);
+	batch->factors[batch->amount] = factor;
+	batch->user_ctxs[batch->amount] = user_ctx;
+	++batch->amount;
+	return true;
+}
+
+
+/// Lerps every pending batch and delivers it to it's setter
+static void WyncLerp_batch_flush_all (WyncCtx *ctx) {
+	WyncWrapperCtx *wrapper = ctx->wrapper;
+
+	for (u32 i = 0; i < wrapper->lerp_batch_pending_amount; ++i) {
+		u16 user_type_id = wrapper->lerp_batch_pending_types[i];
+		WyncWrapper_LerpBatch *batch = &wrapper->lerp_batches[user_type_id];
+		u8 kernel = wrapper->lerp_kernel[user_type_id];
+		u32 stride = batch->stride;
+
+		// the kernels are elementwise (per quaternion for the quat ones), so
+		// consecutive props sharing a factor are lerped in a single run
+
+		u32 k = 0;
+		while (k < batch->amount) {
+			u32 end = k +1;
+			while (end < batch->amount
+				&& batch->factors[end] == batch->factors[k]) {
+				++end;
+			}
+			size_t offset = (size_t)k * stride;
+			WyncLerp_kernel_dispatch(kernel, batch->lefts + offset,
+				batch->rights + offset, batch->outs + offset,
+				(end - k) * stride, batch->factors[k]);
+			k = end;
+		}
+		for (k = 0; k < batch->amount; ++k) {
+			batch->datas[k] = (WyncWrapper_Data) {
+				stride, batch->outs + (size_t)k * stride };
+		}
+
+		batch->setter(batch->user_ctxs, batch->datas, batch->amount);
+		batch->amount = 0;
+	}
+	wrapper->lerp_batch_pending_amount = 0;
+}
+
+
+// ==================================================
+// Dead reckoning
+// ==================================================
+
+/// Lerps or extrapolates a confirmed F32 prop and applies the pending error
+/// correction, the result is left in the lerp scratch
+/// @returns error
+static i32 WyncLerp_dead_reckon (
+	WyncCtx *ctx,
+	WyncProp *prop,
+	float factor,
+	float now_ms
+) {
+	WyncProp_Lerp *lerp = &prop->co_lerp;
+	u32 size = lerp->lerp_left_state.data_size;
+	if (size > WYNC_GETTER_SCRATCH_SIZE
+		|| size != lerp->lerp_right_state.data_size) {
+		return -1;
+	}
+	u32 amount = size / sizeof(float);
+	float *out = (float*)ctx->wrapper->lerp_scratch;
+
+	if (lerp->lerp_tangents_ready) {
+		float *tangents = lerp->lerp_tangents.data;
+		WyncLerp_kernel_hermite(lerp->lerp_left_state.data,
+			lerp->lerp_right_state.data, tangents, tangents + amount,
+			out, amount, factor);
+	} else {
+		WyncLerp_kernel_f32(lerp->lerp_left_state.data,
+			lerp->lerp_right_state.data, out, amount, factor);
+	}
+
+	// late snapshot arrived: error = last extrapolated - new estimate
+
+	if (lerp->lerp_correction_pending) {
+		lerp->lerp_correction_pending = false;
+		lerp->lerp_correcting = false;
+
+		if (lerp->lerp_extrapolated_state.data_size == size
+			&& ctx->co_lerp.extrapolation_correction_ms > 0) {
+			WyncState_set_from_buffer(&lerp->lerp_correction,
+				size, lerp->lerp_extrapolated_state.data);
+			float *offset = lerp->lerp_correction.data;
+			for (u32 i = 0; i < amount; ++i) {
+				offset[i] -= out[i];
+			}
+			lerp->lerp_correction_start_ms = now_ms;
+			lerp->lerp_correcting = true;
+		}
+	}
+
+	if (lerp->lerp_correcting) {
+		float weight = 1.f - (now_ms - lerp->lerp_correction_start_ms)
+			/ (float)ctx->co_lerp.extrapolation_correction_ms;
+		if (weight <= 0 || lerp->lerp_correction.data_size != size) {
+			lerp->lerp_correcting = false;
+		} else {
+			weight = MIN(weight, 1.f);
+			const float *offset = lerp->lerp_correction.data;
+			for (u32 i = 0; i < amount; ++i) {
+				out[i] += offset[i] * weight;
+			}
+		}
+	}
+
+	if (lerp->lerp_extrapolating) {
+		WyncState_set_from_buffer(&lerp->lerp_extrapolated_state, size, out);
+	}
+	return OK;
+}
+
+
 // ==================================================
 // Public API
 // ==================================================
@@ -228,6 +852,35 @@ void WyncLerp_set_max_lerp_factor_symmetric(
 }
 
 
+void WyncLerp_client_set_adaptive_lerp_ms(
+	WyncCtx *ctx,
+	u32 min_ms,
+	u32 max_ms,
+	float underrun_target
+) {
+	CoLerp *co_lerp = &ctx->co_lerp;
+	co_lerp->adaptive_enabled = max_ms > 0;
+	co_lerp->adaptive_min_ms = (u16)MIN(min_ms, UINT16_MAX);
+	co_lerp->adaptive_max_ms = (u16)MAX(MIN(max_ms, UINT16_MAX), min_ms);
+	co_lerp->adaptive_underrun_target = MAX(MIN(underrun_target, 1.f), 0.f);
+	co_lerp->adaptive_window_ticks = 0;
+	co_lerp->adaptive_window_underruns = 0;
+	co_lerp->lerp_ms = (u16)MAX(MIN(
+		co_lerp->lerp_ms, co_lerp->adaptive_max_ms), co_lerp->adaptive_min_ms);
+}
+
+
+void WyncLerp_set_extrapolation(
+	WyncCtx *ctx,
+	u32 max_ms,
+	u32 correction_ms
+) {
+	ctx->co_lerp.extrapolation_max_ms = (u16)MIN(max_ms, UINT16_MAX);
+	ctx->co_lerp.extrapolation_correction_ms =
+		(u16)MIN(correction_ms, UINT16_MAX);
+}
+
+
 void WyncLerp_handle_packet_client_set_lerp_ms(
 	WyncCtx *ctx,
 	WyncPktClientSetLerpMS pkt,
@@ -255,13 +908,34 @@ void WyncLerp_precompute(WyncCtx *ctx) {
 	float target_time_conf = curr_time - ctx->co_lerp.lerp_ms - ctx->co_lerp.lerp_latency_ms;
 
 
+	// snapshot timestamps shifted, every pair must be recomputed
+
+	float delay_ms = (float)ctx->co_lerp.lerp_ms + ctx->co_lerp.lerp_latency_ms;
+	bool recompute_all =
+		ctx->co_lerp.precomputed_server_tick_offset
+			!= ctx->co_ticks.server_tick_offset
+		|| ctx->co_lerp.precomputed_delay_ms != delay_ms;
+	ctx->co_lerp.precomputed_server_tick_offset =
+		ctx->co_ticks.server_tick_offset;
+	ctx->co_lerp.precomputed_delay_ms = delay_ms;
+
+	// props that got new state
+
+	WyncProp *prop = NULL;
+	u32_DynArrIterator it = { 0 };
+	while (u32_DynArr_iterator_get_next(
+		&ctx->co_filter_c.type_state__newstate_prop_ids, &it) == OK)
+	{
+		prop = WyncTrack_get_prop_unsafe(ctx, *it.item);
+		prop->co_lerp.lerp_next_boundary_ms = -INFINITY;
+	}
+
 	// precompute which ticks we'll be interpolating
 	// TODO: might want to use another filtered prop list for 'predicted'.
 	// Before doing that we might need to settled on our strategy for extrapolation as fallback
 	// of interpolation for confirmed states
 
-	u32_DynArrIterator it = { 0 };
-	WyncProp *prop = NULL;
+	it = (u32_DynArrIterator) { 0 };
 	while (u32_DynArr_iterator_get_next(
 		&ctx->co_filter_c.type_state__interpolated_regular_prop_ids, &it) == OK)
 	{
@@ -270,9 +944,13 @@ void WyncLerp_precompute(WyncCtx *ctx) {
 
 		if (prop->xtrap_enabled) {
 			WyncLerp_precompute_predicted(ctx, prop);
-		} else {
-			WyncLerp_precompute_confirmed_states(ctx, prop, target_time_conf);
+			continue;
+		}
+		if (!recompute_all
+			&& target_time_conf < prop->co_lerp.lerp_next_boundary_ms) {
+			continue;
 		}
+		WyncLerp_precompute_confirmed_states(ctx, prop, target_time_conf);
 	}
 }
 
@@ -292,6 +970,48 @@ void WyncLerp_register_lerp_type (
 		assert(false);
 	}
 	ctx->wrapper->lerp_function[user_type_id] = lerp_func;
+	ctx->wrapper->lerp_kernel[user_type_id] = WYNC_LERP_KERNEL_NONE;
+}
+
+
+/// @returns error
+i32 WyncLerp_register_lerp_kernel (
+	WyncCtx *ctx,
+	u16 user_type_id,
+	enum WYNC_LERP_KERNEL kernel
+){
+	if (user_type_id >= WYNC_MAX_USER_TYPES) {
+		LOG_ERR_C(ctx, "User type outside allowed range");
+		return -1;
+	}
+	if (kernel <= WYNC_LERP_KERNEL_NONE || kernel >= WYNC_LERP_KERNEL_AMOUNT) {
+		LOG_ERR_C(ctx, "Invalid lerp kernel %d", kernel);
+		return -2;
+	}
+	ctx->wrapper->lerp_kernel[user_type_id] = (u8)kernel;
+	return OK;
+}
+
+
+/// @returns error
+i32 WyncLerp_register_batch_setter (
+	WyncCtx *ctx,
+	u16 user_type_id,
+	WyncWrapper_BatchSetter setter
+){
+	if (user_type_id >= WYNC_MAX_USER_TYPES) {
+		LOG_ERR_C(ctx, "User type outside allowed range");
+		return -1;
+	}
+	ctx->wrapper->lerp_batches[user_type_id].setter = setter;
+	return OK;
+}
+
+
+bool WyncLerp_is_type_registered (WyncCtx *ctx, u16 user_type_id) {
+	return user_type_id < WYNC_MAX_USER_TYPES && (
+		ctx->wrapper->lerp_kernel[user_type_id] != WYNC_LERP_KERNEL_NONE
+		|| ctx->wrapper->lerp_function[user_type_id] != NULL);
 }
 
 
@@ -313,6 +1033,9 @@ void WyncLerp_interpolate_all (
 	float target_time_pred = delta_fraction_ms;
 	float target_time_conf = delta_fraction_ms
 		- frame - ctx->co_lerp.lerp_ms - ctx->co_lerp.lerp_latency_ms;
+	float now_ms = WyncClock_get_tick_timestamp_ms(ctx, ctx->common.ticks)
+		+ delta_fraction_ms;
+	float extrapolation_max_ms = ctx->co_lerp.extrapolation_max_ms;
 
 	// time between last rendered tick and current frame target
 
@@ -334,9 +1057,8 @@ void WyncLerp_interpolate_all (
 	float factor = 0;
 
 	WyncProp *prop = NULL;
-	WyncWrapper_Setter *setter_lerp;
-	WyncWrapper_UserCtx *user_ctx;
-	WyncWrapper_LerpFunc *lerp_func;
+	WyncWrapper_Setter setter_lerp;
+	WyncWrapper_UserCtx user_ctx;
 
 	WyncState left_value = { 0 };
 	WyncState right_value = { 0 };
@@ -362,15 +1084,11 @@ void WyncLerp_interpolate_all (
 		right_timestamp_ms =
 			(prop->co_lerp.lerp_right_local_tick - (i32)ctx->common.ticks) * frame;
 				
-		setter_lerp = &ctx->wrapper->prop_setter_lerp[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-		lerp_func =
-			&ctx->wrapper->lerp_function[prop->co_lerp.lerp_user_data_type];
-
-		if (setter_lerp == NULL || user_ctx == NULL || lerp_func == NULL ||
-			*setter_lerp == NULL || *lerp_func == NULL) {
-			LOG_ERR_C(ctx,
-					"Invalid Lerp function, Setter function or User context");
+		setter_lerp = ctx->wrapper->prop_setter_lerp[prop_id];
+		user_ctx = ctx->wrapper->prop_user_ctx[prop_id];
+
+		if (setter_lerp == NULL) {
+			LOG_ERR_C(ctx, "Invalid Setter function for prop %u", prop_id);
 			continue;
 		}
 		
@@ -379,7 +1097,7 @@ void WyncLerp_interpolate_all (
 			lerped_state =
 				(WyncWrapper_Data) { right_value.data_size, right_value.data };
 
-			(*setter_lerp)( *user_ctx, lerped_state);
+			setter_lerp(user_ctx, lerped_state);
 			continue;
 		}
 
@@ -387,20 +1105,56 @@ void WyncLerp_interpolate_all (
 			prop->co_lerp.lerp_use_confirmed_state ?
 			target_time_conf : target_time_pred) - left_timestamp_ms)
 			/ (right_timestamp_ms - left_timestamp_ms);
-		factor = MAX(MIN(factor, factor_max), factor_min);
+		factor = MAX(factor, factor_min);
+
+		if (prop->co_lerp.lerp_use_confirmed_state
+			&& extrapolation_max_ms > 0) {
+			// dead reckoning: capped in time instead of by factor
+
+			float overshoot_ms = target_time_conf - right_timestamp_ms;
+			prop->co_lerp.lerp_extrapolating = overshoot_ms > 0;
+			if (overshoot_ms > 0) {
+				factor = 1 + MIN(overshoot_ms, extrapolation_max_ms)
+					/ (right_timestamp_ms - left_timestamp_ms);
+			}
+
+			if (ctx->wrapper->lerp_kernel[prop->co_lerp.lerp_user_data_type]
+					== WYNC_LERP_KERNEL_F32
+				&& WyncLerp_dead_reckon(ctx, prop, factor, now_ms) == OK) {
+				setter_lerp(user_ctx, (WyncWrapper_Data) {
+					left_value.data_size, ctx->wrapper->lerp_scratch });
+				continue;
+			}
+		}
+		else {
+			factor = MIN(factor, factor_max);
+		}
 
-		lerped_state = (*lerp_func) (
-			(WyncWrapper_Data) { left_value.data_size, left_value.data },
-			(WyncWrapper_Data) { right_value.data_size, right_value.data },
-			factor
-		);
+		if (prop->co_lerp.lerp_use_confirmed_state
+			&& prop->co_lerp.lerp_tangents_ready
+			&& left_value.data_size <= WYNC_GETTER_SCRATCH_SIZE) {
+			u32 amount = left_value.data_size / sizeof(float);
+			float *tangents = prop->co_lerp.lerp_tangents.data;
+			WyncLerp_kernel_hermite(left_value.data, right_value.data,
+				tangents, tangents + amount,
+				(float*)ctx->wrapper->lerp_scratch, amount, factor);
+			setter_lerp(user_ctx, (WyncWrapper_Data) {
+				left_value.data_size, ctx->wrapper->lerp_scratch });
+			continue;
+		}
 
-		(*setter_lerp)( *user_ctx, lerped_state);
+		if (WyncLerp_batch_try_push(ctx, prop->co_lerp.lerp_user_data_type,
+			left_value, right_value, factor, user_ctx)) {
+			continue;
+		}
 
-		WyncState lerped_state_to_free =
-			(WyncState) {lerped_state.data_size, lerped_state.data};
-		WyncState_free(&lerped_state_to_free);
+		if (WyncLerp_lerp_and_set(ctx, prop_id, prop->co_lerp.lerp_user_data_type,
+			left_value, right_value, factor, setter_lerp, user_ctx) != OK) {
+			LOG_ERR_C(ctx, "Couldn't interpolate prop %u", prop_id);
+		}
 	}
+
+	WyncLerp_batch_flush_all(ctx);
 }
 
 
@@ -416,12 +1170,8 @@ void WyncLerp_reset_to_interpolated_absolute  (
 	float frame = 1000.0 / ctx->common.physic_ticks_per_second;
 	WyncState left_state;
 	WyncState right_state;
-	WyncWrapper_Data lerped_state;
 
 	WyncProp *prop = NULL;
-	WyncWrapper_Setter *setter;
-	WyncWrapper_UserCtx *user_ctx;
-	WyncWrapper_LerpFunc *lerp_func;
 
 	// then interpolate them
 
@@ -433,37 +1183,27 @@ void WyncLerp_reset_to_interpolated_absolute  (
 			continue;
 		}
 
-		left_state = WyncState_prop_state_buffer_get(prop, tick_left);
-		right_state = WyncState_prop_state_buffer_get(prop, tick_left +1);
+		left_state = WyncTimewarp_prop_state_get(prop, tick_left, 0);
+		right_state = WyncTimewarp_prop_state_get(prop, tick_left +1, 1);
 		if (left_state.data_size == 0 || right_state.data_size == 0) {
 			LOG_WAR_C(ctx, "debugtimewarp, NOT FOUND one of: "
 					"tick_left %u or tick_right %u", tick_left, tick_left+1);
 			continue;
 		}
 
-		// TODO: wrap this into a function
-
-		setter = &ctx->wrapper->prop_setter[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-		lerp_func =
-			&ctx->wrapper->lerp_function[prop->co_lerp.lerp_user_data_type];
-
-		if (setter == NULL || user_ctx == NULL || lerp_func == NULL) {
-			LOG_ERR_C(ctx,
-					"Invalid Lerp function, Setter function or User context");
+		if (!WyncWrapper_prop_has_setter(ctx, prop_id)) {
+			LOG_ERR_C(ctx, "Invalid Setter function for prop %u", prop_id);
 			continue;
 		}
 
-		lerped_state = (*lerp_func) (
-			(WyncWrapper_Data) { left_state.data_size, left_state.data },
-			(WyncWrapper_Data) { right_state.data_size, right_state.data },
-			(lerp_delta_ms / frame)
-		);
-
-		(*setter)( *user_ctx, lerped_state);
-
-		WyncState lerped_state_to_free =
-			(WyncState) {lerped_state.data_size, lerped_state.data};
-		WyncState_free(&lerped_state_to_free);
+		// a NULL setter falls back to the batch setter
+		if (WyncLerp_lerp_and_set(ctx, prop_id, prop->co_lerp.lerp_user_data_type,
+			left_state, right_state, (lerp_delta_ms / frame),
+			ctx->wrapper->prop_setter[prop_id],
+			ctx->wrapper->prop_user_ctx[prop_id]) != OK) {
+			LOG_ERR_C(ctx, "Couldn't interpolate prop %u", prop_id);
+		}
 	}
+
+	WyncWrapper_flush_batch_setters(ctx);
 }
@@ -22,6 +22,18 @@ void WyncStat_setup_prob_for_entity_update_delay_ticks(
 
 void WyncStat_calculate_data_per_tick(WyncCtx *ctx);
 
+void WyncStat_client_clock_request_sent(WyncCtx *ctx);
+
+void WyncStat_client_clock_response_received(WyncCtx *ctx);
+
+void WyncStat_get_prediction_metrics(WyncCtx *ctx, WyncStat_Prediction *out);
+
+i32 WyncStat_get_prop_prediction_error(
+    WyncCtx *ctx, u32 prop_id, WyncStat_PredictionError *out);
+
+i32 WyncStat_get_entity_prediction_error(
+    WyncCtx *ctx, u32 entity_id, WyncStat_PredictionError *out);
+
 /// Wrapper
 /// vvvvvvv
 
@@ -143,6 +155,7 @@ void wync_init_ctx_prediction_data(WyncCtx *ctx);
 void wync_init_ctx_lerp(WyncCtx *ctx);
 void wync_init_ctx_dummy(WyncCtx *ctx);
 void wync_init_ctx_filter_s(WyncCtx *ctx);
+void wync_init_ctx_timewarp(WyncCtx *ctx);
 void wync_init_ctx_filter_c(WyncCtx *ctx);
 
 /// ---------------------------------------------------------------------------
@@ -201,9 +214,17 @@ bool WyncJoin_out_client_just_connected_to_server(WyncCtx *ctx);
 void WyncLerp_client_set_lerp_ms(
     WyncCtx *ctx, float server_tick_rate, u32 lerp_ms);
 
+void WyncLerp_client_set_adaptive_lerp_ms(
+    WyncCtx *ctx, u32 min_ms, u32 max_ms, float underrun_target);
+
+void WyncLerp_client_adapt_lerp_ms(WyncCtx *ctx);
+
 void WyncLerp_set_max_lerp_factor_symmetric(
     WyncCtx *ctx, float max_lerp_factor_symmetric);
 
+void WyncLerp_set_extrapolation(
+    WyncCtx *ctx, u32 max_ms, u32 correction_ms);
+
 void WyncLerp_handle_packet_client_set_lerp_ms(
     WyncCtx *ctx, WyncPktClientSetLerpMS pkt, u32 from_nete_peer_id);
 
@@ -212,6 +233,18 @@ void WyncLerp_precompute(WyncCtx *ctx);
 void WyncLerp_register_lerp_type(
     WyncCtx *ctx, u16 user_type_id, WyncWrapper_LerpFunc lerp_func);
 
+i32 WyncLerp_register_lerp_kernel(
+    WyncCtx *ctx, u16 user_type_id, enum WYNC_LERP_KERNEL kernel);
+
+i32 WyncLerp_run_kernel(
+    enum WYNC_LERP_KERNEL kernel, WyncWrapper_Data from, WyncWrapper_Data to,
+    float delta, void *out);
+
+i32 WyncLerp_register_batch_setter(
+    WyncCtx *ctx, u16 user_type_id, WyncWrapper_BatchSetter setter);
+
+bool WyncLerp_is_type_registered(WyncCtx *ctx, u16 user_type_id);
+
 void WyncLerp_interpolate_all(WyncCtx *ctx, float delta_lerp_fraction);
 
 void WyncLerp_reset_to_interpolated_absolute(
@@ -225,12 +258,26 @@ void WyncLerp_reset_to_interpolated_absolute(
 /// @returns error
 i32 WyncProp_enable_prediction(WyncCtx *ctx, u32 prop_id);
 
+i32 WyncProp_set_prediction_tolerance(
+    WyncCtx *ctx, u32 prop_id, WyncWrapper_DistanceFunc distance_func,
+    float epsilon);
+
 i32 WyncProp_enable_interpolation(
     WyncCtx *ctx, u32 prop_id, u16 user_data_type,
     WyncWrapper_Setter setter_lerp);
 
+i32 WyncProp_set_interpolation_mode(
+    WyncCtx *ctx, u32 prop_id, enum WYNC_LERP_MODE mode,
+    u32 velocity_prop_id);
+
 i32 WyncProp_enable_module_events_consumed(WyncCtx *ctx, u32 prop_id);
 
+u32 WyncProp_get_history_depth(WyncCtx *ctx, WyncProp *prop);
+
+void WyncProp_history_create(WyncCtx *ctx, WyncProp *prop);
+
+i32 WyncProp_set_history_depth(WyncCtx *ctx, u32 prop_id, u32 depth);
+
 /// ---------------------------------------------------------------------------
 /// WYNC SPAWN
 /// ---------------------------------------------------------------------------
@@ -287,15 +334,32 @@ void WyncState_reset_props_to_latest_value(WyncCtx *ctx);
 /// WYNC STATE STORE
 /// ---------------------------------------------------------------------------
 
+void WyncStore_prop_state_buffer_create(WyncProp *prop, u32 size);
+
+void WyncStore_prop_state_buffer_use_slab(WyncProp *prop, u32 stride);
+
+u32 WyncStore_prop_state_buffer_bytes(WyncProp *prop);
+
 void WyncStore_prop_state_buffer_insert(
     WyncCtx *ctx, WyncProp *prop, i32 tick, WyncState state);
 
-void WyncStore_prop_state_buffer_insert_in_place(
-    WyncCtx *ctx, WyncProp *prop, i32 tick, WyncState state);
+void WyncStore_prop_state_buffer_insert_copy(
+    WyncCtx *ctx, WyncProp *prop, i32 tick, u32 data_size, void *data);
+
+void WyncStore_prop_state_buffer_insert_in_place_copy(
+    WyncCtx *ctx, WyncProp *prop, i32 tick, u32 data_size, void *data);
 
 i32 WyncStore_save_confirmed_state(
     WyncCtx *ctx, u32 prop_id, u32 tick, WyncState state);
 
+char *WyncStore_prop_state_buffer_next_slot(WyncProp *prop, u32 *out_capacity);
+
+i32 WyncStore_prop_state_buffer_commit_slot(
+    WyncCtx *ctx, WyncProp *prop, i32 tick, u32 data_size);
+
+i32 WyncStore_save_confirmed_state_copy(
+    WyncCtx *ctx, u32 prop_id, u32 tick, u32 data_size, void *data);
+
 void WyncStore_client_update_last_tick_received(WyncCtx *ctx, u32 tick);
 
 void WyncStore_client_update_last_pkt_received(WyncCtx *ctx);
@@ -312,11 +376,7 @@ i32 WyncStore_server_handle_pkt_inputs(
 
 i32 WyncStore_client_handle_pkt_inputs(WyncCtx *ctx, WyncPktInputs pkt);
 
-void WyncStore_prop_state_buffer_insert(
-    WyncCtx *ctx, WyncProp *prop, i32 tick, WyncState state);
-
-void WyncStore_prop_state_buffer_insert_in_place(
-    WyncCtx *ctx, WyncProp *prop, i32 tick, WyncState state);
+i32 WyncStore_server_update_input_ack(WyncCtx *ctx, WyncProp *prop);
 
 i32 WyncStore_insert_state_to_entity_prop(
     WyncCtx *ctx, u32 entity_id, const char *prop_name_id, u32 tick,
@@ -324,8 +384,6 @@ i32 WyncStore_insert_state_to_entity_prop(
 
 WyncState WyncState_prop_state_buffer_get(WyncProp *prop, i32 tick);
 
-WyncState WyncState_prop_state_buffer_get_throughout(WyncProp *prop, u32 tick);
-
 /// ---------------------------------------------------------------------------
 /// WYNC THROTTLE
 /// ---------------------------------------------------------------------------
@@ -365,6 +423,17 @@ i32 WyncOffsetCollection_get_less_common(CoTicks *co_ticks);
 
 void WyncOffsetCollection_add_value(CoTicks *co_ticks, i32 new_value);
 
+/// ---------------------------------------------------------------------------
+/// WYNC TIMEWARP
+/// ---------------------------------------------------------------------------
+
+void WyncTimewarp_record_history(WyncCtx *ctx, i32 tick);
+
+u32 WyncTimewarp_prop_history_bytes(WyncProp *prop);
+
+WyncState WyncTimewarp_prop_state_get(
+    WyncProp *prop, i32 tick, u32 decoded_slot);
+
 /// ---------------------------------------------------------------------------
 /// WYNC TRACK
 /// ---------------------------------------------------------------------------
@@ -383,6 +452,12 @@ i32 WyncTrack_prop_register_minimal(
     WyncCtx *ctx, u32 entity_id, const char *name_id,
     enum WYNC_PROP_TYPE data_type, u32 *out_prop_id);
 
+i32 WyncTrack_prop_register_sized(
+    WyncCtx *ctx, u32 entity_id, const char *name_id,
+    enum WYNC_PROP_TYPE data_type, u32 max_data_size, u32 *out_prop_id);
+
+void WyncTrack_prop_update_hot_flags(WyncCtx *ctx, u32 prop_id);
+
 WyncProp *WyncTrack_get_prop(WyncCtx *ctx, u32 prop_id);
 
 WyncProp *WyncTrack_entity_get_prop(
@@ -432,13 +507,20 @@ static void WyncXtrap_props_update_predicted_states_ticks(
 
 // void WyncXtrap_save_latest_predicted_state(WyncCtx *ctx, i32 tick);
 
-static i32 WyncXtrap_entity_get_last_received_tick_from_pred_props(
-    WyncCtx *ctx, u32 entity_id);
-
 static void WyncXtrap_internal_tick_end(WyncCtx *ctx, i32 tick);
 
-/// NOTE: assuming snap props always include all snaps for an entity
-void WyncXtrap_update_entity_last_tick_received(WyncCtx *ctx, u32 prop_id);
+void WyncXtrap_update_entity_last_tick_received(
+    WyncCtx *ctx, u32 prop_id, i32 prev_tick);
+
+void WyncXtrap_set_resimulation_budget(WyncCtx *ctx, u32 max_entity_ticks);
+
+WyncState WyncXtrap_prop_get_predicted_state(WyncProp *prop, i32 tick);
+
+bool WyncXtrap_prop_prediction_matches(
+    WyncCtx *ctx, WyncProp *prop, u32 prop_id, i32 tick);
+
+i32 WyncXtrap_get_predicted_state(
+    WyncCtx *ctx, u32 prop_id, i32 tick, WyncWrapper_Data *out_state);
 
 void WyncXtrap_tick_end(WyncCtx *ctx, i32 tick);
 
@@ -454,6 +536,30 @@ void WyncWrapper_set_prop_callbacks(
     WyncCtx *ctx, u32 prop_id, WyncWrapper_UserCtx user_ctx,
     WyncWrapper_Getter getter, WyncWrapper_Setter setter);
 
+void WyncWrapper_set_prop_callbacks_into(
+    WyncCtx *ctx, u32 prop_id, WyncWrapper_UserCtx user_ctx,
+    WyncWrapper_GetterInto getter_into, WyncWrapper_Setter setter);
+
+i32 WyncWrapper_register_batch_callbacks(
+    WyncCtx *ctx, u32 entity_type_id, const char *prop_name,
+    WyncWrapper_BatchGetter getter, WyncWrapper_BatchSetter setter);
+
+void WyncWrapper_batch_assign_prop(WyncCtx *ctx, u32 prop_id, u32 entity_id);
+
+void WyncWrapper_set_prop_state(WyncCtx *ctx, u32 prop_id, WyncState state);
+
+void WyncWrapper_set_prop_state_copy(
+    WyncCtx *ctx, u32 prop_id, WyncState state);
+
+bool WyncWrapper_prop_has_setter(WyncCtx *ctx, u32 prop_id);
+
+void WyncWrapper_flush_batch_setters(WyncCtx *ctx);
+
+i32 WyncWrapper_extract_prop_to_tick(WyncCtx *ctx, u32 prop_id, i32 tick);
+
+i32 WyncWrapper_get_prop_state_shared(
+    WyncCtx *ctx, u32 prop_id, WyncState *out_state, bool *out_must_free);
+
 void WyncWrapper_buffer_inputs(WyncCtx *ctx);
 
 void WyncWrapper_extract_data_to_tick(WyncCtx *ctx, u32 save_on_tick);
@@ -2,6 +2,83 @@
 #include "wync_private.h"
 #include "wync_wrapper.h"
 #include "assert.h"
+#include "math.h"
+
+static u32 WyncProp_round_up_pow2 (u32 n) {
+	u32 pow2 = 1;
+	while (pow2 < n) {
+		pow2 <<= 1;
+	}
+	return pow2;
+}
+
+
+/// @returns State history size needed by the prop, a power of two
+u32 WyncProp_get_history_depth (WyncCtx *ctx, WyncProp *prop) {
+	u32 depth;
+
+	if (prop->history_depth > 0) {
+		depth = prop->history_depth;
+	}
+	else if (prop->prop_type == WYNC_PROP_TYPE_INPUT
+		|| prop->prop_type == WYNC_PROP_TYPE_EVENT) {
+		depth = ctx->common.is_client ?
+			INPUT_BUFFER_SIZE : SERVER_INPUT_BUFFER_SIZE;
+	}
+	else if (prop->relative_sync_enabled) {
+		depth = 2; // base state and real state
+	}
+	else if (prop->lerp_enabled || prop->xtrap_enabled) {
+		depth = ctx->co_track.REGULAR_PROP_CACHED_STATE_AMOUNT;
+	}
+	else {
+		depth = 2; // latest state and one arriving out of order
+	}
+
+	if (prop->timewarp_enabled && prop->co_tw.records == NULL) {
+		depth = MAX(depth, ctx->max_tick_history_timewarp);
+	}
+
+	return WyncProp_round_up_pow2(depth);
+}
+
+
+/// (Re)creates the prop's state history for it's current features,
+/// discarding stored states
+void WyncProp_history_create (WyncCtx *ctx, WyncProp *prop) {
+	u32 depth = WyncProp_get_history_depth(ctx, prop);
+	free(prop->statebff.last_ticks_received.buffer);
+	prop->statebff.last_ticks_received = i32_RinBuf_create(depth, -1);
+	WyncStore_prop_state_buffer_create(prop, depth);
+}
+
+
+/// Recreates the history only if a newly enabled feature needs more depth
+static void WyncProp_history_fit (WyncCtx *ctx, WyncProp *prop) {
+	if (WyncProp_get_history_depth(ctx, prop)
+		!= prop->statebff.saved_states.size) {
+		WyncProp_history_create(ctx, prop);
+	}
+}
+
+
+/// Discards stored history
+/// @returns error
+i32 WyncProp_set_history_depth (WyncCtx *ctx, u32 prop_id, u32 depth) {
+	WyncProp *prop = WyncTrack_get_prop(ctx, prop_id);
+	if (prop == NULL) {
+		return -1;
+	}
+	if (depth == 0 || depth > INPUT_BUFFER_SIZE) {
+		LOG_ERR_C(ctx, "Invalid history depth (%u) for prop %u", depth, prop_id);
+		return -2;
+	}
+
+	prop->history_depth = depth;
+	WyncProp_history_create(ctx, prop);
+	return OK;
+}
+
 
 /// @returns error
 i32 WyncProp_enable_prediction (WyncCtx *ctx, u32 prop_id){
@@ -11,6 +88,30 @@ i32 WyncProp_enable_prediction (WyncCtx *ctx, u32 prop_id){
 	}
 
 	prop->xtrap_enabled = true;
+	prop->co_xtrap.pred_history = (WyncProp_PredState*) calloc(
+		PRED_STATE_HISTORY_SIZE, sizeof(WyncProp_PredState));
+	for (u32 i = 0; i < PRED_STATE_HISTORY_SIZE; ++i) {
+		prop->co_xtrap.pred_history[i].tick = -1;
+	}
+	WyncProp_history_fit(ctx, prop);
+	WyncTrack_prop_update_hot_flags(ctx, prop_id);
+	return OK;
+}
+
+
+/// @returns error
+i32 WyncProp_set_prediction_tolerance (
+	WyncCtx *ctx,
+	u32 prop_id,
+	WyncWrapper_DistanceFunc distance_func,
+	float epsilon
+) {
+	WyncProp *prop = WyncTrack_get_prop(ctx, prop_id);
+	if (prop == NULL || !prop->xtrap_enabled) {
+		return -1;
+	}
+	ctx->wrapper->prop_pred_distance[prop_id] = distance_func;
+	prop->co_xtrap.pred_tolerance = distance_func != NULL ? MAX(epsilon, 0) : 0;
 	return OK;
 }
 
@@ -36,7 +137,7 @@ i32 WyncProp_enable_interpolation (
 
 	// check lerp type exists
 
-	if (ctx->wrapper->lerp_function[user_data_type] == NULL) {
+	if (!WyncLerp_is_type_registered(ctx, user_data_type)) {
 		LOG_ERR_C(ctx, "Provided data type (%u) is NOT registered for Lerping",
 				user_data_type);
 		assert(false);
@@ -48,13 +149,45 @@ i32 WyncProp_enable_interpolation (
 	assert(setter_lerp != NULL);
 	
 	prop->lerp_enabled = true;
+	WyncTrack_prop_update_hot_flags(ctx, prop_id);
 	prop->co_lerp.lerp_user_data_type = user_data_type;
 	ctx->wrapper->prop_setter_lerp[prop_id] = setter_lerp;
+	WyncProp_history_fit(ctx, prop);
 	
 	return OK;
 }
 
 
+/// @returns error
+i32 WyncProp_set_interpolation_mode (
+	WyncCtx *ctx,
+	u32 prop_id,
+	enum WYNC_LERP_MODE mode,
+	u32 velocity_prop_id
+) {
+	WyncProp *prop = WyncTrack_get_prop(ctx, prop_id);
+	if (prop == NULL || !prop->lerp_enabled) {
+		return -1;
+	}
+	if (mode != WYNC_LERP_MODE_LINEAR && ctx->wrapper->lerp_kernel
+		[prop->co_lerp.lerp_user_data_type] != WYNC_LERP_KERNEL_F32) {
+		LOG_ERR_C(ctx, "Cubic lerp requires WYNC_LERP_KERNEL_F32 (prop %u)",
+			prop_id);
+		return -2;
+	}
+	if (mode == WYNC_LERP_MODE_HERMITE
+		&& WyncTrack_get_prop(ctx, velocity_prop_id) == NULL) {
+		return -3;
+	}
+
+	prop->co_lerp.lerp_mode = (u8)mode;
+	prop->co_lerp.lerp_velocity_prop_id = velocity_prop_id;
+	prop->co_lerp.lerp_tangents_ready = false;
+	prop->co_lerp.lerp_next_boundary_ms = -INFINITY; // recompute
+	return OK;
+}
+
+
 i32 WyncProp_enable_module_events_consumed (
 	WyncCtx *ctx,
 	u32 prop_id
@@ -67,6 +200,7 @@ i32 WyncProp_enable_module_events_consumed (
 		return OK;
 	}
 	prop->consumed_events_enabled = true;
+	WyncTrack_prop_update_hot_flags(ctx, prop_id);
 
 	prop->co_consumed.events_consumed_at_tick_tick = i32_RinBuf_create(
 			ctx->common.max_age_user_events_for_consumption, -1);
@@ -118,21 +252,14 @@ int WyncProp_enable_relative_sync (
 	}
 
 	prop->relative_sync_enabled = true;
+	WyncTrack_prop_update_hot_flags(ctx, prop_id);
 	prop->co_rela.delta_blueprint_id = delta_blueprint_id;
 
 	// assuming no timewarpable
 	// minimum storage allowed 0 or 2
 	// TODO: create new methods for resizing containers, reusing existing memory
 
-	uint buffer_items = 2;
-	prop->statebff.saved_states = WyncState_RinBuf_create
-		(buffer_items, (WyncState){ 0 });
-	prop->statebff.state_id_to_tick = i32_RinBuf_create
-		(buffer_items, -1);
-	prop->statebff.tick_to_state_id = i32_RinBuf_create
-		(buffer_items, -1);
-	prop->statebff.state_id_to_local_tick = i32_RinBuf_create
-		(buffer_items, -1); // only for lerp
+	WyncProp_history_create(ctx, prop);
 
 	bool need_undo_events = false;
 	if (ctx->common.is_client && predictable) {
@@ -188,6 +315,7 @@ int WyncProp_enable_relative_sync (
 
 	WyncProp *aux_prop = WyncTrack_get_prop_unsafe(ctx, events_prop_id);
 	aux_prop->is_auxiliar_prop = true;
+	WyncTrack_prop_update_hot_flags(ctx, events_prop_id);
 	WyncProp_enable_prediction(ctx, events_prop_id);
 
 	aux_prop->auxiliar_delta_events_prop_id = prop_id;
@@ -214,15 +342,26 @@ int WyncProp_enable_timewarp (
 	}
 
 	prop->timewarp_enabled = true;
+	WyncTrack_prop_update_hot_flags(ctx, prop_id);
+
+	u32 keyframe_interval = ctx->timewarp_keyframe_interval;
+	if (keyframe_interval > 0) {
+		// room for the window plus the chain back to its oldest keyframe
+		WyncProp_Timewarp *tw = &prop->co_tw;
+		tw->keyframe_interval = keyframe_interval;
+		tw->record_ticks = ctx->max_tick_history_timewarp + keyframe_interval;
+		tw->records = (WyncTimewarp_Record*) calloc(
+			tw->record_ticks, sizeof(WyncTimewarp_Record));
+		for (u32 i = 0; i < tw->record_ticks; ++i) {
+			tw->records[i].tick = -1;
+		}
+		tw->last_tick = -1;
+		tw->prev_tick = -1;
+		tw->decoded_tick[0] = -1;
+		tw->decoded_tick[1] = -1;
+	}
 
-	prop->statebff.saved_states = WyncState_RinBuf_create
-		(ctx->max_tick_history_timewarp, (WyncState){ 0 });
-	prop->statebff.state_id_to_tick = i32_RinBuf_create
-		(ctx->max_tick_history_timewarp, -1);
-	prop->statebff.tick_to_state_id = i32_RinBuf_create
-		(ctx->max_tick_history_timewarp, -1);
-	prop->statebff.state_id_to_local_tick = i32_RinBuf_create
-		(ctx->max_tick_history_timewarp, -1); // TODO: this is only for lerp
+	WyncProp_history_create(ctx, prop);
 
 	return OK;
 }
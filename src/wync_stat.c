@@ -45,6 +45,79 @@ void WyncStat_system_calculate_prob_prop_rate(WyncCtx *ctx) {
 
 
 
+void WyncStat_get_prediction_metrics (WyncCtx *ctx, WyncStat_Prediction *out) {
+	CoMetrics *metrics = &ctx->co_metrics;
+	*out = (WyncStat_Prediction) {
+		metrics->xtrap_entity_ticks_simulated,
+		metrics->xtrap_entity_ticks_resimulated,
+		metrics->xtrap_entities_over_budget,
+		metrics->xtrap_predictions_checked,
+		metrics->xtrap_mispredictions
+	};
+}
+
+
+static void WyncStat_accumulate_prediction_error (
+	WyncProp *prop,
+	WyncStat_PredictionError *out,
+	float *error_sum
+) {
+	out->predictions_checked += prop->co_xtrap.pred_checked;
+	out->mispredictions += prop->co_xtrap.pred_mispredicted;
+	out->error_samples += prop->co_xtrap.pred_error_samples;
+	out->error_max = MAX(out->error_max, prop->co_xtrap.pred_error_max);
+	*error_sum += prop->co_xtrap.pred_error_sum;
+}
+
+
+/// @returns error
+i32 WyncStat_get_prop_prediction_error (
+	WyncCtx *ctx,
+	u32 prop_id,
+	WyncStat_PredictionError *out
+) {
+	WyncProp *prop = WyncTrack_get_prop(ctx, prop_id);
+	if (prop == NULL || !prop->xtrap_enabled) {
+		return -1;
+	}
+	*out = (WyncStat_PredictionError) { 0 };
+	float error_sum = 0;
+	WyncStat_accumulate_prediction_error(prop, out, &error_sum);
+	if (out->error_samples > 0) {
+		out->error_mean = error_sum / (float)out->error_samples;
+	}
+	return OK;
+}
+
+
+/// @returns error
+i32 WyncStat_get_entity_prediction_error (
+	WyncCtx *ctx,
+	u32 entity_id,
+	WyncStat_PredictionError *out
+) {
+	u32_DynArr *entity_props = NULL;
+	i32 err = u32_DynArr_ConMap_get(
+		&ctx->co_track.entity_has_props, entity_id, &entity_props);
+	if (err != OK) {
+		return -1;
+	}
+
+	*out = (WyncStat_PredictionError) { 0 };
+	float error_sum = 0;
+	u32_DynArrIterator it = { 0 };
+	while (u32_DynArr_iterator_get_next(entity_props, &it) == OK) {
+		WyncProp *prop = WyncTrack_get_prop(ctx, *it.item);
+		if (prop == NULL || !prop->xtrap_enabled) { continue; }
+		WyncStat_accumulate_prediction_error(prop, out, &error_sum);
+	}
+	if (out->error_samples > 0) {
+		out->error_mean = error_sum / (float)out->error_samples;
+	}
+	return OK;
+}
+
+
 // ==================================================
 // WRAPPER
 // ==================================================
@@ -152,3 +225,41 @@ void WyncStat_calculate_data_per_tick (WyncCtx *ctx) {
 	metrics->debug_data_per_tick_sliding_window_mean = (float)data_sent_acc
 		/ (float)ctx->co_metrics.debug_data_per_tick_sliding_window_size;
 }
+
+
+/// (client only) Call when receiving a clock response
+void WyncStat_client_clock_response_received (WyncCtx *ctx) {
+	++ctx->co_metrics.packet_loss_responses_received;
+}
+
+
+/// (client only) Call when sending a clock request. Every
+/// PACKET_LOSS_SAMPLE_SIZE requests the packet loss is estimated and the
+/// input redundancy is adjusted so that losing every copy of an input is
+/// unlikely (below 0.1%)
+void WyncStat_client_clock_request_sent (WyncCtx *ctx) {
+	CoMetrics *metrics = &ctx->co_metrics;
+
+	++metrics->packet_loss_requests_sent;
+	if (metrics->packet_loss_requests_sent <= PACKET_LOSS_SAMPLE_SIZE) {
+		return;
+	}
+
+	// the request just sent belongs to the next sample
+
+	u32 sent = metrics->packet_loss_requests_sent -1;
+	u32 received = MIN(metrics->packet_loss_responses_received, sent);
+	float sample_loss = (float)(sent - received) / (float)sent;
+
+	metrics->packet_loss = (metrics->packet_loss + sample_loss) / 2.f;
+	metrics->packet_loss_requests_sent = 1;
+	metrics->packet_loss_responses_received = 0;
+
+	u32 amount = INPUT_AMOUNT_TO_SEND_MIN;
+	float all_lost = powf(metrics->packet_loss, (float)amount);
+	while (all_lost > 0.001f && amount < INPUT_AMOUNT_TO_SEND) {
+		all_lost *= metrics->packet_loss;
+		++amount;
+	}
+	metrics->input_amount_to_send = amount;
+}
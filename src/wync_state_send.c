@@ -124,8 +124,10 @@ void WyncSend_prop_event_send_event_ids_to_peer(
 	// collect inputs
 
 	WyncTickDecorator_DynArr_clear_preserving_capacity(&input_list);
+
+	// same redundancy as inputs, adapted to the measured packet loss
 	
-	for (uint tick = ctx->common.ticks - INPUT_AMOUNT_TO_SEND;
+	for (uint tick = ctx->common.ticks - ctx->co_metrics.input_amount_to_send;
 		tick < ctx->common.ticks +1; ++tick)
 	{
 		WyncState input = WyncState_prop_state_buffer_get(prop, tick);
@@ -398,6 +400,51 @@ void WyncSend_extracted_data(WyncCtx *ctx) {
 }
 
 
+/// Acks the inputs received from the client's input/event props
+///
+/// @param[out] pkt Allocates it's 'input_acks'
+/// @returns Whether an ack advanced through newly received inputs, an ack
+/// only moved by the passing of ticks isn't worth it's own packet
+static bool WyncSend_fill_input_acks (
+	WyncCtx *ctx,
+	u16 client_id,
+	WyncPktSnap *pkt
+) {
+	bool advanced = false;
+	ConMap *owns_props = &ctx->co_clientauth.client_owns_prop[client_id];
+	pkt->input_ack_amount = 0;
+	pkt->input_acks = (WyncPktSnap_InputAck*)
+		calloc(sizeof(WyncPktSnap_InputAck), owns_props->pair_count);
+
+	ConMapIterator it = { 0 };
+	while (ConMap_iterator_get_next_key(owns_props, &it) == OK) {
+		u32 prop_id = it.key;
+		WyncProp *prop = WyncTrack_get_prop(ctx, prop_id);
+		if (prop == NULL || prop->prop_type == WYNC_PROP_TYPE_STATE) {
+			continue;
+		}
+		WyncPktSnap_InputAck *ack =
+			&pkt->input_acks[pkt->input_ack_amount++];
+		ack->prop_id = prop_id;
+		ack->tick = WyncStore_server_update_input_ack(ctx, prop);
+
+		if (ack->tick > prop->statebff.input_ack_tick_sent
+			&& WyncState_prop_state_buffer_get(prop, ack->tick).data != NULL) {
+			advanced = true;
+		}
+	}
+	return advanced;
+}
+
+static void WyncSend_mark_input_acks_sent (WyncCtx *ctx, WyncPktSnap *pkt) {
+	for (u16 i = 0; i < pkt->input_ack_amount; ++i) {
+		WyncProp *prop = WyncTrack_get_prop_unsafe(
+			ctx, pkt->input_acks[i].prop_id);
+		prop->statebff.input_ack_tick_sent = pkt->input_acks[i].tick;
+	}
+}
+
+
 void WyncSend_queue_out_snapshots_for_delivery (WyncCtx *ctx) {
 
 	u32 peer_amount = (u32)i32_DynArr_get_size(&ctx->common.peers);
@@ -442,9 +489,12 @@ void WyncSend_queue_out_snapshots_for_delivery (WyncCtx *ctx) {
 			WyncPktSnap_free(&pkt_rel_snap);
 		}
 
-		// unreliable
+		// unreliable, acks for the client's inputs go along
 
-		if (pkt_unrel_snap.snap_amount > 0) {
+		bool acks_advanced =
+			WyncSend_fill_input_acks(ctx, client_id, &pkt_unrel_snap);
+
+		if (pkt_unrel_snap.snap_amount > 0 || acks_advanced) {
 
 			pkt_unrel_snap.snaps = (WyncSnap*)
 				calloc(sizeof(WyncSnap), pkt_unrel_snap.snap_amount);
@@ -463,9 +513,9 @@ void WyncSend_queue_out_snapshots_for_delivery (WyncCtx *ctx) {
 				UNRELIABLE,
 				true
 			);
-
-			WyncPktSnap_free(&pkt_unrel_snap);
+			WyncSend_mark_input_acks_sent(ctx, &pkt_unrel_snap);
 		}
+		WyncPktSnap_free(&pkt_unrel_snap);
 
 		WyncSnap_DynArr_clear_preserving_capacity(reliable);
 		WyncSnap_DynArr_clear_preserving_capacity(unreliable);
@@ -524,9 +574,14 @@ void WyncSend_client_send_inputs (WyncCtx *ctx) {
 
 		// extract stored inputs
 
-		for ( u32 i = ctx->co_pred.target_tick - INPUT_AMOUNT_TO_SEND;
-			i < ctx->co_pred.target_tick; ++i
-		){
+		// only inputs the server hasn't acked
+
+		i32 first_tick = MAX(
+			(i32)ctx->co_pred.target_tick
+				- (i32)ctx->co_metrics.input_amount_to_send,
+			input_prop->statebff.input_ack_tick +1);
+
+		for ( u32 i = (u32)first_tick; i < ctx->co_pred.target_tick; ++i){
 			WyncState input = WyncState_prop_state_buffer_get(input_prop, i);
 
 			if (input.data_size == 0 || input.data == NULL) {
@@ -567,6 +622,9 @@ void WyncSend_client_send_inputs (WyncCtx *ctx) {
 		pkt_inputs = (WyncPktInputs) { 0 };
 		pkt_inputs.prop_id = prop_id;
 		pkt_inputs.amount = (u32)WyncTickDecorator_DynArr_get_size(&input_list);
+		if (pkt_inputs.amount == 0) {
+			continue;
+		}
 		pkt_inputs.inputs = (WyncTickDecorator*)
 			calloc(sizeof(WyncTickDecorator), pkt_inputs.amount);
 
@@ -28,8 +28,6 @@ void WyncState_reset_all_state_to_confirmed_tick_absolute(
 	u32 tick
 ) {
 	WyncProp *prop;
-	WyncWrapper_Setter *setter;
-	WyncWrapper_UserCtx *user_ctx;
 
 	for (u32 i = 0; i < prop_id_amount; ++i) {
 		u32 prop_id = prop_ids[i];
@@ -39,7 +37,7 @@ void WyncState_reset_all_state_to_confirmed_tick_absolute(
 			continue;
 		}
 
-		WyncState state = WyncState_prop_state_buffer_get(prop, tick);
+		WyncState state = WyncTimewarp_prop_state_get(prop, tick, 0);
 		if (state.data_size == 0 || state.data == NULL) {
 			if (!ctx->common.is_client && prop->prop_type != WYNC_PROP_TYPE_STATE) {
 				LOG_WAR_C(ctx, "No input for prop %u (%s) tick %d",
@@ -48,11 +46,10 @@ void WyncState_reset_all_state_to_confirmed_tick_absolute(
 			continue;
 		}
 
-		setter = &ctx->wrapper->prop_setter[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-		if (*setter == NULL) continue;
-		(*setter)(*user_ctx, (WyncWrapper_Data){ state.data_size, state.data });
+		WyncWrapper_set_prop_state(ctx, prop_id, state);
 	}
+
+	WyncWrapper_flush_batch_setters(ctx);
 }
 
 void WyncState_reset_all_state_to_confirmed_tick_relative(
@@ -61,9 +58,6 @@ void WyncState_reset_all_state_to_confirmed_tick_relative(
 	u32 prop_id_amount,
 	u32 tick
 ) {
-	WyncWrapper_Setter *setter;
-	WyncWrapper_UserCtx *user_ctx;
-
 	for (u32 i = 0; i < prop_id_amount; ++i) {
 		u32 prop_id = prop_ids[i];
 
@@ -83,16 +77,15 @@ void WyncState_reset_all_state_to_confirmed_tick_relative(
 			continue;
 		}
 
-		setter = &ctx->wrapper->prop_setter[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-		if (*setter == NULL) continue;
-		(*setter)(*user_ctx, (WyncWrapper_Data){ state.data_size, state.data });
+		WyncWrapper_set_prop_state(ctx, prop_id, state);
 
 		if (prop->relative_sync_enabled) {
 			LOG_OUT_C(ctx, "debugdelta, Setted absolute state for prop(%u) %s",
 			prop_id, prop->name_id);
 		}
 	}
+
+	WyncWrapper_flush_batch_setters(ctx);
 }
 
 
@@ -311,6 +304,9 @@ void WyncState_delta_props_update_and_apply_delta_events (WyncCtx *ctx)
 void WyncState_reset_props_to_latest_value (WyncCtx *ctx) {
 	u32_DynArr_clear_preserving_capacity(
 		&ctx->co_filter_c.type_state__newstate_prop_ids);
+	u32_DynArr_clear_preserving_capacity(
+		&ctx->co_filter_c.type_state__rollback_prop_ids);
+	u32_DynArr_clear_preserving_capacity(&ctx->co_pred.diverged_entity_ids);
 
 	ConMapIterator it = { 0 };
 	while(ConMap_iterator_get_next_key(
@@ -318,17 +314,20 @@ void WyncState_reset_props_to_latest_value (WyncCtx *ctx) {
 	{
 		u32 prop_id = it.key;
 
-		WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
-
-		if (prop->prop_type != WYNC_PROP_TYPE_STATE) { continue; }
-		if (!prop->statebff.just_received_new_state) { continue; }
+		if (ctx->co_track.prop_type[prop_id] != WYNC_PROP_TYPE_STATE) {
+			continue;
+		}
+		u16 *flags = &ctx->co_track.prop_flags[prop_id];
+		if (!(*flags & WYNC_PROP_FLAG_JUST_RECEIVED_NEW_STATE)) { continue; }
 
-		prop->statebff.just_received_new_state = false;
+		*flags &= ~WYNC_PROP_FLAG_JUST_RECEIVED_NEW_STATE;
 
 		u32_DynArr_insert(
 			&ctx->co_filter_c.type_state__newstate_prop_ids, prop_id);
 
-		if (!prop->xtrap_enabled) { continue; }
+		if (!(*flags & WYNC_PROP_FLAG_XTRAP)) { continue; }
+
+		WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
 
 		/*if (!prop->relative_sync_enabled) { */
 
@@ -342,19 +341,50 @@ void WyncState_reset_props_to_latest_value (WyncCtx *ctx) {
 			}
 			i32 last_ticks_received = *i32_RinBuf_get_relative(
 				&prop->statebff.last_ticks_received, 0);
+
+			// predicted right, nothing to rollback
+
+			if (WyncXtrap_prop_prediction_matches(
+				ctx, prop, prop_id, last_ticks_received)) {
+				continue;
+			}
+
 			ConMap_set_pair(&ctx->co_pred.entity_last_predicted_tick,
 				entity_id, last_ticks_received);
+			if (!u32_DynArr_has(&ctx->co_pred.diverged_entity_ids, entity_id)) {
+				u32_DynArr_insert(&ctx->co_pred.diverged_entity_ids, entity_id);
+			}
 
 		/*} else { // rela prop*/
 			/*// ...*/
 		/*}*/
 	}
 
+	// predicted props are only reset along with their diverged entity,
+	// (an entity is re-predicted as a whole)
+
+	u32_DynArrIterator it_new = { 0 };
+	while (u32_DynArr_iterator_get_next(
+		&ctx->co_filter_c.type_state__newstate_prop_ids, &it_new) == OK)
+	{
+		u32 prop_id = *it_new.item;
+		if (ctx->co_track.prop_flags[prop_id] & WYNC_PROP_FLAG_XTRAP) {
+			u32 entity_id = 0;
+			i32 err = WyncTrack_prop_get_entity(ctx, prop_id, &entity_id);
+			if (err == OK && !u32_DynArr_has(
+				&ctx->co_pred.diverged_entity_ids, entity_id)) {
+				continue;
+			}
+		}
+		u32_DynArr_insert(
+			&ctx->co_filter_c.type_state__rollback_prop_ids, prop_id);
+	}
+
 	// rest state to _canonic_
 
 	WyncState_reset_all_state_to_confirmed_tick_relative(
-		ctx, ctx->co_filter_c.type_state__newstate_prop_ids.items,
-		ctx->co_filter_c.type_state__newstate_prop_ids.size, 0);
+		ctx, ctx->co_filter_c.type_state__rollback_prop_ids.items,
+		ctx->co_filter_c.type_state__rollback_prop_ids.size, 0);
 
 	// only rollback if new state was received and is applicable:
 
@@ -5,7 +5,8 @@
 // TODO: Move me elsewhere
 void WyncXtrap_update_entity_last_tick_received(
 	WyncCtx *ctx,
-	u32 prop_id
+	u32 prop_id,
+	i32 prev_tick
 );
 
 
@@ -16,11 +17,12 @@ void WyncStore_prop_state_buffer_insert(
 	WyncState state
 );
 
-void WyncStore_prop_state_buffer_insert_in_place(
+void WyncStore_prop_state_buffer_insert_in_place_copy(
 	WyncCtx *ctx,
 	WyncProp *prop,
 	i32 tick,
-	WyncState state
+	u32 data_size,
+	void *data
 );
 
 i32 WyncStore_save_confirmed_state(
@@ -85,41 +87,48 @@ void WyncStore_handle_pkt_prop_snap(
 		i32 last_tick_received =
 			*i32_RinBuf_get_relative(&prop->statebff.last_ticks_received, 0);
 
-		if ( !((i32)pkt.tick > (last_tick_received -
-			ctx->co_track.REGULAR_PROP_CACHED_STATE_AMOUNT))
-		) {
+		// shallow histories only take ticks they can hold without evicting
+		// the latest one
+		i32 window = (i32)MIN(ctx->co_track.REGULAR_PROP_CACHED_STATE_AMOUNT,
+			prop->statebff.saved_states.size);
+		if ( !((i32)pkt.tick > (last_tick_received - window))) {
 			continue;
 		}
 
-		WyncState state_copy = WyncState_copy_from_buffer(
-				snap->data.data_size, snap->data.data);
-
-		i32 err = WyncStore_save_confirmed_state(
-			ctx, snap->prop_id, pkt.tick, state_copy);
+		i32 err = WyncStore_save_confirmed_state_copy(ctx, snap->prop_id,
+			pkt.tick, snap->data.data_size, snap->data.data);
 
 		if (err != OK) {
-			WyncState_free(&state_copy);
 			continue;
 		}
 
 		// update entity last received
-		if (prop->xtrap_enabled) {
-			WyncXtrap_update_entity_last_tick_received(ctx, snap->prop_id);
+		WyncXtrap_update_entity_last_tick_received(
+			ctx, snap->prop_id, last_tick_received);
+	}
+
+	// inputs the server already has
+
+	for (u32 i = 0; i < pkt.input_ack_amount; ++i) {
+		WyncPktSnap_InputAck *ack = &pkt.input_acks[i];
+		WyncProp *prop = WyncTrack_get_prop(ctx, ack->prop_id);
+		if (prop == NULL) {
+			continue;
 		}
+		prop->statebff.input_ack_tick =
+			MAX(prop->statebff.input_ack_tick, ack->tick);
 	}
 
 	WyncStore_client_update_last_tick_received(ctx, pkt.tick);
 }
 
-/// Transfer ownership of the data
-///
-/// @param state Must be Pre-allocated
-/// @returns error
-i32 WyncStore_save_confirmed_state(
+static i32 WyncStore_save_confirmed_state_ex(
 	WyncCtx *ctx,
 	u32 prop_id,
 	u32 tick,
-	WyncState state
+	u32 data_size,
+	void *data,
+	bool take_ownership
 ) {
 	WyncProp *prop = WyncTrack_get_prop(ctx, prop_id);
 	if (prop == NULL) {
@@ -127,17 +136,22 @@ i32 WyncStore_save_confirmed_state(
 		return -1;
 	}
 
-	prop->statebff.just_received_new_state = true;
+	ctx->co_track.prop_flags[prop_id] |= WYNC_PROP_FLAG_JUST_RECEIVED_NEW_STATE;
 
-	i32_RinBuf_push(&prop->statebff.last_ticks_received, tick, NULL, NULL);
-	i32_RinBuf_sort(&prop->statebff.last_ticks_received);
+	i32_RinBuf_insert_sorted(&prop->statebff.last_ticks_received, tick);
 	i32_RinBuf_insert_at(
 		&prop->statebff.state_id_to_local_tick,
 		prop->statebff.saved_states.head_pointer,
 		ctx->common.ticks
 	);
 
-	WyncStore_prop_state_buffer_insert(ctx, prop, tick, state);
+	if (take_ownership) {
+		WyncStore_prop_state_buffer_insert(
+			ctx, prop, tick, (WyncState) { data_size, data });
+	} else {
+		WyncStore_prop_state_buffer_insert_copy(
+			ctx, prop, tick, data_size, data);
+	}
 
 	if (prop->relative_sync_enabled) {
 		// FIXME: check for max? what about unordered packets?
@@ -154,6 +168,34 @@ i32 WyncStore_save_confirmed_state(
 	return OK;
 }
 
+/// Transfer ownership of the data
+///
+/// @param state Must be Pre-allocated
+/// @returns error
+i32 WyncStore_save_confirmed_state(
+	WyncCtx *ctx,
+	u32 prop_id,
+	u32 tick,
+	WyncState state
+) {
+	return WyncStore_save_confirmed_state_ex(
+		ctx, prop_id, tick, state.data_size, state.data, true);
+}
+
+/// Stores it's own copy of the data
+///
+/// @returns error
+i32 WyncStore_save_confirmed_state_copy(
+	WyncCtx *ctx,
+	u32 prop_id,
+	u32 tick,
+	u32 data_size,
+	void *data
+) {
+	return WyncStore_save_confirmed_state_ex(
+		ctx, prop_id, tick, data_size, data, false);
+}
+
 void WyncStore_service_cleanup_dummy_props(WyncCtx *ctx) {
 	// run every few frames
 	if (FAST_MODULUS(ctx->common.ticks, 16) != 0) return;
@@ -227,11 +269,14 @@ i32 WyncStore_server_handle_pkt_inputs(
 			continue;
 		}
 
-		WyncState state_copy =
-			WyncState_copy_from_buffer(input->state.data_size, input->state.data);
+		// already have it
 
-		WyncStore_prop_state_buffer_insert_in_place(
-			ctx, prop_input, input->tick, state_copy);
+		if ((i32)input->tick <= prop_input->statebff.input_ack_tick) {
+			continue;
+		}
+
+		WyncStore_prop_state_buffer_insert_in_place_copy(ctx, prop_input,
+			input->tick, input->state.data_size, input->state.data);
 
 		// TODO: Reject input that is too old
 	}
@@ -240,6 +285,23 @@ i32 WyncStore_server_handle_pkt_inputs(
 }
 
 
+/// Advances the input ack of a client owned input/event prop through the
+/// inputs received contiguously. Inputs for ticks already simulated are
+/// no longer needed, so the ack never stays behind the current tick.
+///
+/// @returns input ack tick
+i32 WyncStore_server_update_input_ack(WyncCtx *ctx, WyncProp *prop) {
+	WyncProp_StateBuffer *bff = &prop->statebff;
+	bff->input_ack_tick = MAX(bff->input_ack_tick, (i32)ctx->common.ticks -1);
+
+	while (WyncState_prop_state_buffer_get(
+		prop, bff->input_ack_tick +1).data != NULL) {
+		++bff->input_ack_tick;
+	}
+	return bff->input_ack_tick;
+}
+
+
 /// Creates and stores it's own copy of the data, user must free 'pkt' data
 ///
 /// @returns error
@@ -269,90 +331,419 @@ i32 WyncStore_client_handle_pkt_inputs(
 			continue;
 		}
 
-		WyncState state_copy =
-			WyncState_copy_from_buffer(input->state.data_size, input->state.data);
+		i32 prev_tick = *i32_RinBuf_get_relative(
+			&prop_input->statebff.last_ticks_received, 0);
 
-		WyncStore_prop_state_buffer_insert(
-			ctx, prop_input, input->tick, state_copy);
+		WyncStore_prop_state_buffer_insert_copy(ctx, prop_input,
+			input->tick, input->state.data_size, input->state.data);
+
+		i32_RinBuf_insert_sorted(
+			&prop_input->statebff.last_ticks_received, input->tick);
 
-		i32_RinBuf_push(&prop_input->statebff.last_ticks_received, input->tick,
-				NULL, NULL);
-			
 		max_tick = MAX(max_tick, input->tick);
-	}
 
-	i32_RinBuf_sort(&prop_input->statebff.last_ticks_received);
+		// Update entity last received
+		WyncXtrap_update_entity_last_tick_received(ctx, prop_id, prev_tick);
+	}
 
 	WyncStore_client_update_last_tick_received(ctx, max_tick);
 
-	// Update entity last received
-	if (prop_input->xtrap_enabled) {
-		WyncXtrap_update_entity_last_tick_received(ctx, prop_id);
+	return OK;
+}
+
+
+/// @returns whether the state memory is owned by the prop's slab
+static bool WyncStore_is_state_in_slab (WyncProp *prop, WyncState *state) {
+	WyncProp_StateBuffer *bff = &prop->statebff;
+	if (bff->slab == NULL || state->data == NULL) {
+		return false;
 	}
+	char *data = (char*)state->data;
+	return data >= bff->slab
+		&& data < bff->slab + bff->saved_states.size * bff->slab_stride;
+}
 
-	return OK;
+
+/// Releases a stored state unless it lives in the slab
+static void WyncStore_release_state (WyncProp *prop, WyncState *state) {
+	if (WyncStore_is_state_in_slab(prop, state)) {
+		*state = (WyncState) { 0 };
+		return;
+	}
+	WyncState_free(state);
 }
 
 
-/// Transfers ownership of the data pointers
-void WyncStore_prop_state_buffer_insert(
+// tick -> state_id index
+// 'tick_to_state_id' is an open addressing table (linear probing) with twice
+// the slots of the history, so lookups are O(1) regardless of arrival order.
+// Keys aren't stored, they're read from 'state_id_to_tick'.
+
+/// @param[out] out_pos Table position of the entry
+/// @returns state_id, -1 if not found
+static i32 WyncStore_index_find (
+	WyncProp_StateBuffer *bff,
+	i32 tick,
+	size_t *out_pos
+) {
+	size_t table_size = bff->tick_to_state_id.size;
+	if (tick < 0 || table_size == 0) {
+		return -1;
+	}
+	size_t pos = FAST_MODULUS((size_t)tick, table_size);
+
+	for (size_t i = 0; i < table_size; ++i) {
+		i32 state_id = bff->tick_to_state_id.buffer[pos];
+		if (state_id == -1) {
+			return -1;
+		}
+		if (bff->state_id_to_tick.buffer[state_id] == tick) {
+			if (out_pos != NULL) *out_pos = pos;
+			return state_id;
+		}
+		pos = FAST_MODULUS(pos +1, table_size);
+	}
+	return -1;
+}
+
+
+/// Backward shift deletion, keeps probe sequences intact without tombstones
+static void WyncStore_index_remove_at (WyncProp_StateBuffer *bff, size_t pos) {
+	i32 *table = bff->tick_to_state_id.buffer;
+	size_t table_size = bff->tick_to_state_id.size;
+	size_t hole = pos;
+	size_t next = pos;
+
+	while (true) {
+		next = FAST_MODULUS(next +1, table_size);
+		i32 state_id = table[next];
+		if (state_id == -1) {
+			break;
+		}
+
+		// move entry into the hole unless it's home lies cyclically in
+		// (hole, next]
+		size_t home = FAST_MODULUS(
+			(size_t)bff->state_id_to_tick.buffer[state_id], table_size);
+		bool stays = hole <= next
+			? (hole < home && home <= next)
+			: (hole < home || home <= next);
+		if (stays) {
+			continue;
+		}
+		table[hole] = state_id;
+		hole = next;
+	}
+	table[hole] = -1;
+}
+
+
+/// Associates 'tick' to 'state_id', replacing any previous association
+/// of either of them
+static void WyncStore_index_set (
+	WyncProp_StateBuffer *bff,
+	i32 tick,
+	u32 state_id
+) {
+	size_t pos;
+	i32 old_tick = bff->state_id_to_tick.buffer[state_id];
+	if (WyncStore_index_find(bff, old_tick, &pos) == (i32)state_id) {
+		WyncStore_index_remove_at(bff, pos);
+	}
+	bff->state_id_to_tick.buffer[state_id] = -1;
+
+	if (tick < 0) {
+		return;
+	}
+
+	// a previous state with the same tick is no longer reachable
+	i32 old_state_id = WyncStore_index_find(bff, tick, &pos);
+	if (old_state_id != -1) {
+		WyncStore_index_remove_at(bff, pos);
+		bff->state_id_to_tick.buffer[old_state_id] = -1;
+	}
+
+	bff->state_id_to_tick.buffer[state_id] = tick;
+
+	size_t table_size = bff->tick_to_state_id.size;
+	pos = FAST_MODULUS((size_t)tick, table_size);
+	while (bff->tick_to_state_id.buffer[pos] != -1) {
+		pos = FAST_MODULUS(pos +1, table_size);
+	}
+	bff->tick_to_state_id.buffer[pos] = (i32)state_id;
+}
+
+
+/// (Re)creates the state history rings of a prop, releasing previous ones.
+/// All rings live in a single allocation. If the prop had a slab it's
+/// recreated with the same stride.
+///
+/// @param size MUST be a power of two
+void WyncStore_prop_state_buffer_create (WyncProp *prop, u32 size) {
+	WyncProp_StateBuffer *bff = &prop->statebff;
+
+	if (bff->saved_states.buffer != NULL) {
+		for (size_t i = 0; i < bff->saved_states.size; ++i) {
+			WyncStore_release_state(prop,
+				WyncState_RinBuf_get_absolute(&bff->saved_states, i));
+		}
+	}
+	free(bff->rings_block);
+	free(bff->slab);
+	bff->slab = NULL;
+
+	// layout: saved_states | state_id_to_tick | tick_to_state_id (index,
+	// see WyncStore_index_find) | state_id_to_local_tick (only for lerp)
+
+	size_t ids_amount = (size_t)size * 4;
+	char *block = (char*) malloc(
+		sizeof(WyncState) * size + sizeof(i32) * ids_amount);
+	bff->rings_block = block;
+
+	bff->saved_states = (WyncState_RinBuf) {
+		.size = size, .buffer = (WyncState*)block };
+	i32 *ids = (i32*)(block + sizeof(WyncState) * size);
+	bff->state_id_to_tick = (i32_RinBuf) {
+		.size = size, .buffer = ids };
+	bff->tick_to_state_id = (i32_RinBuf) {
+		.size = size * 2, .buffer = ids + size };
+	bff->state_id_to_local_tick = (i32_RinBuf) {
+		.size = size, .buffer = ids + size * 3 };
+
+	for (size_t i = 0; i < size; ++i) {
+		bff->saved_states.buffer[i] = (WyncState) { 0 };
+	}
+	for (size_t i = 0; i < ids_amount; ++i) {
+		ids[i] = -1;
+	}
+	bff->input_ack_tick = -1;
+	bff->input_ack_tick_sent = -1;
+
+	if (bff->slab_stride > 0) {
+		WyncStore_prop_state_buffer_use_slab(prop, bff->slab_stride);
+	}
+}
+
+
+/// Backs the prop history with a contiguous slab of 'stride' bytes per slot.
+/// Already stored states are kept in their own heap blocks.
+void WyncStore_prop_state_buffer_use_slab (WyncProp *prop, u32 stride) {
+	WyncProp_StateBuffer *bff = &prop->statebff;
+	assert(bff->slab == NULL);
+	if (stride == 0 || bff->saved_states.size == 0) {
+		return;
+	}
+	bff->slab_stride = stride;
+	bff->slab = (char*) calloc(bff->saved_states.size, stride);
+}
+
+
+/// @returns bytes kept by the state history of a prop, rings included
+u32 WyncStore_prop_state_buffer_bytes (WyncProp *prop) {
+	WyncProp_StateBuffer *bff = &prop->statebff;
+
+	// see the layout in WyncStore_prop_state_buffer_create
+	u32 bytes = (u32)(bff->saved_states.size
+		* (sizeof(WyncState) + sizeof(i32) * 4));
+	if (bff->slab != NULL) {
+		bytes += (u32)bff->saved_states.size * bff->slab_stride;
+	}
+	for (size_t i = 0; i < bff->saved_states.size; ++i) {
+		WyncState *state = WyncState_RinBuf_get_absolute(&bff->saved_states, i);
+		if (!WyncStore_is_state_in_slab(prop, state)) {
+			bytes += state->data_size;
+		}
+	}
+	return bytes;
+}
+
+
+/// Fixed size props adopt the size of their first state as slab stride
+static void WyncStore_prop_state_buffer_try_adopt_slab (
+	WyncProp *prop,
+	u32 data_size
+) {
+	if (prop->statebff.slab != NULL || prop->statebff.slab_stride != 0) {
+		return;
+	}
+	// relative props hold full snapshots and events hold event lists, both
+	// are variable in size
+	if (prop->prop_type == WYNC_PROP_TYPE_EVENT || prop->relative_sync_enabled) {
+		return;
+	}
+	WyncStore_prop_state_buffer_use_slab(prop, data_size);
+}
+
+
+/// Stores the state at 'state_id', copying it into the slab when it fits
+///
+/// @param take_ownership If false 'data' is copied
+static void WyncStore_prop_state_buffer_set_slot (
+	WyncProp *prop,
+	u32 state_id,
+	u32 data_size,
+	void *data,
+	bool take_ownership
+) {
+	WyncProp_StateBuffer *bff = &prop->statebff;
+	WyncState *slot = WyncState_RinBuf_get_absolute(&bff->saved_states, state_id);
+	WyncStore_release_state(prop, slot);
+
+	if (bff->slab != NULL && data_size <= bff->slab_stride) {
+		char *slab_slot = bff->slab + (size_t)state_id * bff->slab_stride;
+		memcpy(slab_slot, data, data_size);
+		*slot = (WyncState) { data_size, slab_slot };
+
+		if (take_ownership) {
+			WyncState owned = { data_size, data };
+			WyncState_free(&owned);
+		}
+		return;
+	}
+
+	if (take_ownership) {
+		*slot = (WyncState) { data_size, data };
+	} else {
+		*slot = WyncState_copy_from_buffer(data_size, data);
+	}
+}
+
+
+static void WyncStore_prop_state_buffer_push (
 	WyncCtx *ctx,
 	WyncProp *prop,
 	i32 tick,
-	WyncState state
+	u32 data_size,
+	void *data,
+	bool take_ownership
 ){
 	if (tick < 0) return;
-	WyncState replaced_state = { 0 };
-	i32 state_idx;
 
-	if (state.data_size == 0 || state.data == NULL) {
+	if (data_size == 0 || data == NULL) {
 		LOG_WAR_C(ctx, "Tried to buffer empty state");
 		return;
 	}
 
-	//
-	i32 err = WyncState_RinBuf_push(
-			&prop->statebff.saved_states, state,
-			NULL, &replaced_state);
+	WyncStore_prop_state_buffer_try_adopt_slab(prop, data_size);
+
+	// reserve next slot, the old state is released when setting the slot
+
+	size_t state_idx;
+	WyncState *saved_states_head = WyncState_RinBuf_get_relative(
+		&prop->statebff.saved_states, 1);
+	if (saved_states_head == NULL) { return; }
 
+	i32 err = WyncState_RinBuf_push(
+			&prop->statebff.saved_states, *saved_states_head,
+			&state_idx, NULL);
 	if (err != OK) { return; }
 
-	// free whatever old state is found if any
-	WyncState_free(&replaced_state);
+	WyncStore_prop_state_buffer_set_slot(
+		prop, (u32)state_idx, data_size, data, take_ownership);
 
-	state_idx = prop->statebff.saved_states.head_pointer;
-	i32_RinBuf_insert_at(&prop->statebff.state_id_to_tick, state_idx, tick);
-	i32_RinBuf_insert_at(&prop->statebff.tick_to_state_id, tick, state_idx);
+	WyncStore_index_set(&prop->statebff, tick, (u32)state_idx);
 }
 
+
 /// Transfers ownership of the data pointers
-void WyncStore_prop_state_buffer_insert_in_place(
+void WyncStore_prop_state_buffer_insert(
 	WyncCtx *ctx,
 	WyncProp *prop,
 	i32 tick,
 	WyncState state
 ){
-	if (tick < 0) return;
+	WyncStore_prop_state_buffer_push(
+		ctx, prop, tick, state.data_size, state.data, true);
+}
 
-	i32 state_id = *i32_RinBuf_get_at(&prop->statebff.tick_to_state_id, tick);
-	if (state_id == -1) {
-		WyncStore_prop_state_buffer_insert(ctx, prop, tick, state);
-		return;
+
+/// Copies the data. Doesn't allocate for slab backed props
+void WyncStore_prop_state_buffer_insert_copy(
+	WyncCtx *ctx,
+	WyncProp *prop,
+	i32 tick,
+	u32 data_size,
+	void *data
+){
+	WyncStore_prop_state_buffer_push(
+		ctx, prop, tick, data_size, data, false);
+}
+
+
+/// Direct write access to the next history slot of slab backed props.
+/// The oldest state is only replaced once committed with
+/// WyncStore_prop_state_buffer_commit_slot.
+///
+/// @param[out] out_capacity
+/// @returns Pointer to write into. NULL if the prop isn't slab backed
+char *WyncStore_prop_state_buffer_next_slot (WyncProp *prop, u32 *out_capacity) {
+	WyncProp_StateBuffer *bff = &prop->statebff;
+	if (bff->slab == NULL) {
+		return NULL;
 	}
 
-	i32 stored_tick = *i32_RinBuf_get_absolute(&prop->statebff.state_id_to_tick, state_id);
-	if (tick != stored_tick) {
-		WyncStore_prop_state_buffer_insert(ctx, prop, tick, state);
-		return;
+	size_t state_id = FAST_MODULUS(
+		bff->saved_states.head_pointer + 1, bff->saved_states.size);
+
+	*out_capacity = bff->slab_stride;
+	return bff->slab + state_id * bff->slab_stride;
+}
+
+
+/// Stores the state written to the slot given by
+/// WyncStore_prop_state_buffer_next_slot
+///
+/// @returns error
+i32 WyncStore_prop_state_buffer_commit_slot (
+	WyncCtx *ctx,
+	WyncProp *prop,
+	i32 tick,
+	u32 data_size
+) {
+	WyncProp_StateBuffer *bff = &prop->statebff;
+	if (tick < 0 || bff->slab == NULL) {
+		return -1;
+	}
+	if (data_size == 0 || data_size > bff->slab_stride) {
+		LOG_WAR_C(ctx, "Tried to buffer empty or oversized state (%u)",
+			data_size);
+		return -2;
 	}
 
-	// TODO: deleteme
-	i32_RinBuf_insert_at(&prop->statebff.state_id_to_tick, state_id, tick);
+	size_t state_id;
+	size_t next_id = FAST_MODULUS(
+		bff->saved_states.head_pointer + 1, bff->saved_states.size);
+	WyncState state = { data_size, bff->slab + next_id * bff->slab_stride };
 
-	WyncState replaced_state = { 0 };
-	WyncState_RinBuf_insert_at(&prop->statebff.saved_states, state_id, state);
+	WyncStore_release_state(prop,
+		WyncState_RinBuf_get_absolute(&bff->saved_states, next_id));
 
-	// TODO: reuse existing memory instead of using a new one
+	WyncState_RinBuf_push(&bff->saved_states, state, &state_id, NULL);
+	WyncStore_index_set(bff, tick, (u32)state_id);
+	return OK;
+}
+
+
+/// Replaces the state stored for 'tick' if any. Copies the data, doesn't
+/// allocate for slab backed props
+void WyncStore_prop_state_buffer_insert_in_place_copy(
+	WyncCtx *ctx,
+	WyncProp *prop,
+	i32 tick,
+	u32 data_size,
+	void *data
+){
+	if (tick < 0) return;
+
+	i32 state_id = WyncStore_index_find(&prop->statebff, tick, NULL);
+	if (state_id == -1) {
+		WyncStore_prop_state_buffer_insert_copy(
+			ctx, prop, tick, data_size, data);
+		return;
+	}
+
+	WyncStore_prop_state_buffer_set_slot(
+		prop, (u32)state_id, data_size, data, false);
 }
 
 /// Transfers ownership of the data pointers
@@ -372,10 +763,10 @@ i32 WyncStore_insert_state_to_entity_prop (
 
 	// NOTE: Code below mirrors of 'save_confirmed_state'
 
-	prop->statebff.just_received_new_state = true;
+	u32 prop_id = (u32)(prop - ctx->co_track.props);
+	ctx->co_track.prop_flags[prop_id] |= WYNC_PROP_FLAG_JUST_RECEIVED_NEW_STATE;
 
-	i32_RinBuf_push(&prop->statebff.last_ticks_received, tick, NULL, NULL);
-	i32_RinBuf_sort(&prop->statebff.last_ticks_received);
+	i32_RinBuf_insert_sorted(&prop->statebff.last_ticks_received, tick);
 
 	WyncStore_prop_state_buffer_insert(ctx, prop, tick, state);
 
@@ -388,17 +779,12 @@ i32 WyncStore_insert_state_to_entity_prop (
 	return OK;
 }
 
-/// Main method to access stored state
+/// Main method to access stored state, O(1) regardless of arrival order
 ///
 /// @returns shared state, copy it yourself if needed
 WyncState WyncState_prop_state_buffer_get(WyncProp *prop, i32 tick) {
-	i32 state_id = *i32_RinBuf_get_at(&prop->statebff.tick_to_state_id, tick);
-	if (state_id < 0 || tick < 0) {
-		return (WyncState) { 0 };
-	}
-
-	i32 saved_tick = *i32_RinBuf_get_absolute(&prop->statebff.state_id_to_tick, state_id);
-	if (saved_tick != tick) {
+	i32 state_id = WyncStore_index_find(&prop->statebff, tick, NULL);
+	if (state_id < 0) {
 		return (WyncState) { 0 };
 	}
 
@@ -407,28 +793,3 @@ WyncState WyncState_prop_state_buffer_get(WyncProp *prop, i32 tick) {
 	return stored;
 }
 
-/// TODO: Explain why this cannot be covered by function above ^^^
-///
-/// @returns shared state, copy if needed
-WyncState WyncState_prop_state_buffer_get_throughout (
-	WyncProp *prop,
-	u32 tick
-) {
-	// look up tick
-
-	size_t size = WyncState_RinBuf_get_size(&prop->statebff.saved_states);
-	for (size_t state_id = 0; state_id < size; ++state_id) {
-
-		u32 saved_tick = *i32_RinBuf_get_absolute(
-			&prop->statebff.state_id_to_tick, state_id);
-
-		if (saved_tick == tick) {
-			WyncState stored = *WyncState_RinBuf_get_absolute(
-				&prop->statebff.saved_states, state_id);
-			return stored;
-		}
-	}
-
-	return (WyncState) { 0 };
-}
-
@@ -19,6 +19,335 @@ bool WyncTimewarp_can_we_timerwarp_to_this_tick(WyncCtx *ctx, uint32_t tick) {
 }
 
 
+/// @returns error
+int WyncTimewarp_set_compressed_history(
+	WyncCtx *ctx, uint32_t keyframe_interval
+) {
+	if (keyframe_interval > ctx->max_tick_history_timewarp) {
+		LOG_ERR_C(ctx, "Keyframe interval (%u) exceeds the timewarp window (%u)",
+			keyframe_interval, ctx->max_tick_history_timewarp);
+		return -1;
+	}
+	ctx->timewarp_keyframe_interval = keyframe_interval;
+	return OK;
+}
+
+
+/// Writes 'data' as runs of <equal bytes: u8, changed bytes: u8, data ^ base>
+/// 'out' must fit (size * 2 + 2) bytes
+/// @returns encoded size
+static u32 WyncTimewarp_xor_encode (u8 *data, u8 *base, u32 size, u8 *out) {
+	u32 written = 0;
+	u32 i = 0;
+	while (i < size) {
+		u32 header = written;
+		u8 zeros = 0, literals = 0;
+		written += 2;
+		while (i < size && zeros < 0xFF && data[i] == base[i]) {
+			++zeros; ++i;
+		}
+		while (i < size && literals < 0xFF && data[i] != base[i]) {
+			out[written++] = data[i] ^ base[i];
+			++literals; ++i;
+		}
+		out[header] = zeros;
+		out[header +1] = literals;
+	}
+	return written;
+}
+
+
+static void WyncTimewarp_xor_apply (u8 *state, u8 *runs, u32 runs_size) {
+	u32 i = 0;
+	u32 k = 0;
+	while (k < runs_size) {
+		i += runs[k];
+		u8 literals = runs[k +1];
+		k += 2;
+		for (u8 j = 0; j < literals; ++j) {
+			state[i++] ^= runs[k++];
+		}
+	}
+}
+
+
+static WyncTimewarp_Record *WyncTimewarp_record_at (
+	WyncProp_Timewarp *tw, i32 tick
+) {
+	return &tw->records[(u32)tick % tw->record_ticks];
+}
+
+
+/// @returns the record of 'tick' if it's still needed when 'current_tick' is
+/// recorded, NULL otherwise
+static WyncTimewarp_Record *WyncTimewarp_live_record (
+	WyncProp_Timewarp *tw, i32 tick, i32 current_tick
+) {
+	if (tick < 0 || tick >= current_tick
+		|| tick <= current_tick - (i32)tw->record_ticks) {
+		return NULL;
+	}
+	WyncTimewarp_Record *record = WyncTimewarp_record_at(tw, tick);
+	return record->tick == tick ? record : NULL;
+}
+
+
+/// @returns whether [start, start + size) overlaps a record still needed
+/// when 'tick' is recorded, other than the one at 'tick' itself
+static bool WyncTimewarp_arena_overlaps_live (
+	WyncProp_Timewarp *tw, i32 tick, u32 start, u32 size
+) {
+	for (i32 t = tick - (i32)tw->record_ticks +1; t < tick; ++t) {
+		WyncTimewarp_Record *record = WyncTimewarp_live_record(tw, t, tick);
+		if (record == NULL) {
+			continue;
+		}
+		u32 record_size = record->size_flags & ~WYNC_TIMEWARP_KEYFRAME_BIT;
+		if (start < record->start + record_size
+			&& record->start < start + size) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/// Moves the live records into a new arena, back to back from offset 0
+static void WyncTimewarp_arena_grow (
+	WyncProp_Timewarp *tw, i32 tick, u32 size
+) {
+	u32 live = 0;
+	for (i32 t = tick - (i32)tw->record_ticks +1; t < tick; ++t) {
+		WyncTimewarp_Record *record = WyncTimewarp_live_record(tw, t, tick);
+		if (record != NULL) {
+			live += record->size_flags & ~WYNC_TIMEWARP_KEYFRAME_BIT;
+		}
+	}
+
+	// leave room for the live records to grow and for the unused tail
+	u32 arena_size = (live + size) / 2 * 3 + size;
+	char *arena = (char*) malloc(arena_size);
+	u32 head = 0;
+
+	for (i32 t = tick - (i32)tw->record_ticks +1; t < tick; ++t) {
+		WyncTimewarp_Record *record = WyncTimewarp_live_record(tw, t, tick);
+		if (record == NULL) {
+			continue;
+		}
+		u32 record_size = record->size_flags & ~WYNC_TIMEWARP_KEYFRAME_BIT;
+		memcpy(arena + head, tw->arena + record->start, record_size);
+		record->start = head;
+		head += record_size;
+	}
+
+	free(tw->arena);
+	tw->arena = arena;
+	tw->arena_size = arena_size;
+	tw->arena_head = head;
+}
+
+
+/// Copies an encoded record into the arena
+/// @returns arena offset
+static u32 WyncTimewarp_arena_write (
+	WyncProp_Timewarp *tw, i32 tick, char *data, u32 size
+) {
+	while (true) {
+		if (size <= tw->arena_size) {
+			u32 start = tw->arena_head;
+			if (start + size > tw->arena_size) {
+				start = 0;
+			}
+			if (!WyncTimewarp_arena_overlaps_live(tw, tick, start, size)) {
+				memcpy(tw->arena + start, data, size);
+				tw->arena_head = start + size;
+				return start;
+			}
+		}
+		WyncTimewarp_arena_grow(tw, tick, size);
+	}
+}
+
+
+static void WyncTimewarp_record_prop (
+	CoTimewarp *co_timewarp, WyncProp *prop, i32 tick
+) {
+	WyncProp_Timewarp *tw = &prop->co_tw;
+	WyncTimewarp_Record *record = WyncTimewarp_record_at(tw, tick);
+
+	// the latest tick can be extracted again, e.g. at tick end. Older ones
+	// are kept, later deltas depend on them
+	bool is_rerecord = record->tick == tick && tick == tw->last_tick;
+	if ((record->tick == tick && !is_rerecord) || tick < tw->last_tick) {
+		return;
+	}
+
+	WyncState state = WyncState_prop_state_buffer_get(prop, tick);
+	if (state.data == NULL || state.data_size == 0) {
+		return;
+	}
+
+	// base for the delta: the state at tick -1
+
+	if (!is_rerecord) {
+		WyncState swap = tw->prev_state;
+		tw->prev_state = tw->last_state;
+		tw->last_state = swap;
+		tw->prev_tick = tw->last_tick;
+	}
+	WyncState *base = &tw->prev_state;
+
+	bool is_keyframe = tw->keyframe_interval <= 1
+		|| tick % tw->keyframe_interval == 0
+		|| tw->prev_tick != tick -1
+		|| base->data_size != state.data_size;
+
+	u32 capacity = state.data_size * 2 + 2;
+	if (co_timewarp->encode_scratch_size < capacity) {
+		co_timewarp->encode_scratch =
+			(char*) realloc(co_timewarp->encode_scratch, capacity);
+		co_timewarp->encode_scratch_size = capacity;
+	}
+
+	char *encoded = (char*)state.data;
+	u32 encoded_size = state.data_size;
+	if (!is_keyframe) {
+		u32 delta_size = WyncTimewarp_xor_encode(
+			(u8*)state.data, (u8*)base->data, state.data_size,
+			(u8*)co_timewarp->encode_scratch);
+		if (delta_size < state.data_size) {
+			encoded = co_timewarp->encode_scratch;
+			encoded_size = delta_size;
+		} else {
+			is_keyframe = true;
+		}
+	}
+
+	record->tick = tick;
+	record->size_flags = encoded_size
+		| (is_keyframe ? WYNC_TIMEWARP_KEYFRAME_BIT : 0);
+	record->start = WyncTimewarp_arena_write(tw, tick, encoded, encoded_size);
+
+	for (u32 slot = 0; slot < 2; ++slot) {
+		if (tw->decoded_tick[slot] == tick) { tw->decoded_tick[slot] = -1; }
+	}
+
+	WyncState_set_from_buffer(&tw->last_state, state.data_size, state.data);
+	tw->last_tick = tick;
+}
+
+
+/// @returns bytes kept by the state history of a prop plus it's compressed
+/// timewarp history, if any
+u32 WyncTimewarp_prop_history_bytes (WyncProp *prop) {
+	u32 bytes = WyncStore_prop_state_buffer_bytes(prop);
+
+	WyncProp_Timewarp *tw = &prop->co_tw;
+	if (tw->records == NULL) {
+		return bytes;
+	}
+	return bytes
+		+ (u32)sizeof(WyncTimewarp_Record) * tw->record_ticks
+		+ tw->arena_size
+		+ tw->last_state.data_size + tw->prev_state.data_size
+		+ tw->decoded[0].data_size + tw->decoded[1].data_size;
+}
+
+
+/// Appends the states stored at 'tick' to the compressed timewarp history
+void WyncTimewarp_record_history (WyncCtx *ctx, i32 tick) {
+	if (ctx->timewarp_keyframe_interval == 0) {
+		return;
+	}
+
+	u32_DynArrIterator it = { 0 };
+	while (u32_DynArr_iterator_get_next(
+		&ctx->co_filter_s.filtered_regular_timewarpable_prop_ids, &it) == OK)
+	{
+		WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, *it.item);
+		if (prop == NULL || prop->co_tw.records == NULL) {
+			continue;
+		}
+		WyncTimewarp_record_prop(&ctx->co_timewarp, prop, tick);
+	}
+}
+
+
+/// Decodes from the closest keyframe, or from an already decoded tick
+/// @returns decoded state, empty if the tick isn't stored
+static WyncState WyncTimewarp_decode (
+	WyncProp_Timewarp *tw, i32 tick, u32 slot
+) {
+	if (tw->decoded_tick[slot] == tick) {
+		return tw->decoded[slot];
+	}
+
+	u32 other_slot = slot ^ 1;
+	i32 start = tick;
+	i32 base_slot = -1;
+
+	// older records might still sit in slots nobody reused, their arena
+	// bytes don't
+	i32 oldest_tick = tw->last_tick - (i32)tw->record_ticks +1;
+
+	while (true) {
+		if (start < 0 || start < oldest_tick || start > tw->last_tick
+			|| WyncTimewarp_record_at(tw, start)->tick != start) {
+			return (WyncState) { 0 };
+		}
+		if (tw->decoded_tick[slot] == start) {
+			base_slot = (i32)slot;
+			break;
+		}
+		if (tw->decoded_tick[other_slot] == start) {
+			base_slot = (i32)other_slot;
+			break;
+		}
+		if (WyncTimewarp_record_at(tw, start)->size_flags
+			& WYNC_TIMEWARP_KEYFRAME_BIT) {
+			break;
+		}
+		--start;
+	}
+
+	WyncState *out = &tw->decoded[slot];
+	if (base_slot < 0) {
+		WyncTimewarp_Record *keyframe = WyncTimewarp_record_at(tw, start);
+		WyncState_set_from_buffer(out,
+			keyframe->size_flags & ~WYNC_TIMEWARP_KEYFRAME_BIT,
+			tw->arena + keyframe->start);
+	}
+	else if (base_slot != (i32)slot) {
+		WyncState *base = &tw->decoded[base_slot];
+		WyncState_set_from_buffer(out, base->data_size, base->data);
+	}
+
+	for (i32 t = start +1; t <= tick; ++t) {
+		WyncTimewarp_Record *record = WyncTimewarp_record_at(tw, t);
+		WyncTimewarp_xor_apply((u8*)out->data, (u8*)tw->arena + record->start,
+			record->size_flags & ~WYNC_TIMEWARP_KEYFRAME_BIT);
+	}
+
+	tw->decoded_tick[slot] = tick;
+	return *out;
+}
+
+
+/// Reads the state buffer first, then the compressed history.
+/// 'decoded_slot' (0 or 1) lets two decoded states be alive at once
+///
+/// @returns shared state, valid until the slot is decoded again
+WyncState WyncTimewarp_prop_state_get (
+	WyncProp *prop, i32 tick, u32 decoded_slot
+) {
+	WyncState state = WyncState_prop_state_buffer_get(prop, tick);
+	if (state.data != NULL || prop->co_tw.records == NULL) {
+		return state;
+	}
+	return WyncTimewarp_decode(&prop->co_tw, tick, decoded_slot);
+}
+
+
 void WyncTimewarp_cache_current_state_timewarpable_props(WyncCtx *ctx) {
 	WyncWrapper_extract_prop_snapshot_to_tick (
 		ctx,
@@ -28,6 +357,15 @@ void WyncTimewarp_cache_current_state_timewarpable_props(WyncCtx *ctx) {
 		),
 		ctx->co_filter_s.filtered_regular_timewarpable_prop_ids.items
 	);
+	WyncTimewarp_record_history(ctx, (i32)ctx->common.ticks);
+}
+
+
+static void WyncTimewarp_mark_entity_dirty (WyncCtx *ctx, u32 entity_id) {
+	u32_DynArr *dirty_entity_ids = &ctx->co_timewarp.dirty_entity_ids;
+	if (!u32_DynArr_has(dirty_entity_ids, entity_id)) {
+		u32_DynArr_insert(dirty_entity_ids, entity_id);
+	}
 }
 
 
@@ -50,14 +388,16 @@ int WyncTimewarp_warp_entity_to_tick(
 		return -1;
 	}
 
+	WyncTimewarp_mark_entity_dirty(ctx, entity_id);
+
 	u32_DynArrIterator it = { 0 };
 	while (u32_DynArr_iterator_get_next(entity_props, &it) == OK) {
 		uint prop_id = *it.item;
-		WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
+		u16 flags = ctx->co_track.prop_flags[prop_id];
 
-		if (!prop->timewarp_enabled) { continue; }
+		if (!(flags & WYNC_PROP_FLAG_TIMEWARP)) { continue; }
 
-		if (prop->lerp_enabled && !target_is_current_tick) {
+		if ((flags & WYNC_PROP_FLAG_LERP) && !target_is_current_tick) {
 			WyncLerp_reset_to_interpolated_absolute (
 				ctx, &prop_id, 1, tick_left, lerp_delta_ms
 			);
@@ -73,6 +413,26 @@ int WyncTimewarp_warp_entity_to_tick(
 }
 
 
+/// Warps only the given entities, restoring later touches only those
+/// @returns error, -1 if any entity isn't tracked
+int WyncTimewarp_warp_entities_to_tick(
+	WyncCtx *ctx,
+	const uint32_t *entity_ids,
+	uint32_t entity_amount,
+	uint32_t tick_left,
+	float lerp_delta_ms
+) {
+	int error = OK;
+	for (u32 i = 0; i < entity_amount; ++i) {
+		if (WyncTimewarp_warp_entity_to_tick(
+			ctx, entity_ids[i], tick_left, lerp_delta_ms) != OK) {
+			error = -1;
+		}
+	}
+	return error;
+}
+
+
 int WyncTimewarp_warp_to_tick(
 	WyncCtx* ctx, uint32_t tick_left, float lerp_delta_ms
 ) {
@@ -80,6 +440,8 @@ int WyncTimewarp_warp_to_tick(
 	uint tick_origin_target = tick_left + floor(lerp_delta_ms/frame_ms);
 	if (tick_origin_target == ctx->common.ticks) { return OK; }
 
+	ctx->co_timewarp.world_warped = true;
+
 	WyncState_reset_all_state_to_confirmed_tick_absolute (
 		ctx,
 ctx->co_filter_s.filtered_regular_timewarpable_non_interpolable_prop_ids.items,
@@ -98,11 +460,45 @@ ctx->co_filter_s.filtered_regular_timewarpable_interpolable_prop_ids.size,
 }
 
 
+/// Restores only what was warped since the last restore
 void WyncTimewarp_restore_present_state (WyncCtx *ctx) {
-	WyncState_reset_all_state_to_confirmed_tick_absolute (
-		ctx,
-		ctx->co_filter_s.filtered_regular_timewarpable_prop_ids.items,
-		(uint)ctx->co_filter_s.filtered_regular_timewarpable_prop_ids.size,
-		ctx->common.ticks
-	);
+	CoTimewarp *co_timewarp = &ctx->co_timewarp;
+
+	if (co_timewarp->world_warped) {
+		WyncState_reset_all_state_to_confirmed_tick_absolute (
+			ctx,
+			ctx->co_filter_s.filtered_regular_timewarpable_prop_ids.items,
+			(uint)ctx->co_filter_s.filtered_regular_timewarpable_prop_ids.size,
+			ctx->common.ticks
+		);
+	}
+	else if (u32_DynArr_get_size(&co_timewarp->dirty_entity_ids) > 0) {
+		u32_DynArr *prop_ids = &co_timewarp->restore_prop_ids;
+		u32_DynArr_clear_preserving_capacity(prop_ids);
+
+		u32_DynArrIterator it = { 0 };
+		while (u32_DynArr_iterator_get_next(
+			&co_timewarp->dirty_entity_ids, &it) == OK)
+		{
+			u32_DynArr *entity_props = NULL;
+			if (u32_DynArr_ConMap_get(
+				&ctx->co_track.entity_has_props, *it.item, &entity_props) != OK) {
+				continue;
+			}
+
+			u32_DynArrIterator prop_it = { 0 };
+			while (u32_DynArr_iterator_get_next(entity_props, &prop_it) == OK) {
+				u32 prop_id = *prop_it.item;
+				if (ctx->co_track.prop_flags[prop_id] & WYNC_PROP_FLAG_TIMEWARP) {
+					u32_DynArr_insert(prop_ids, prop_id);
+				}
+			}
+		}
+
+		WyncState_reset_all_state_to_confirmed_tick_absolute (
+			ctx, prop_ids->items, (u32)prop_ids->size, ctx->common.ticks);
+	}
+
+	co_timewarp->world_warped = false;
+	u32_DynArr_clear_preserving_capacity(&co_timewarp->dirty_entity_ids);
 }
@@ -62,7 +62,8 @@ i32 WyncTrack_get_new_prop_id (WyncCtx *ctx, u32 *out_prop_id) {
 		if (ctx->co_track.prop_id_cursor >= MAX_PROPS) {
 			ctx->co_track.prop_id_cursor = 0;
 		}
-		if (!ctx->co_track.props[ctx->co_track.prop_id_cursor].enabled) {
+		if (!(ctx->co_track.prop_flags[ctx->co_track.prop_id_cursor]
+			& WYNC_PROP_FLAG_ENABLED)) {
 			*out_prop_id = ctx->co_track.prop_id_cursor;
 			return OK;
 		}
@@ -129,31 +130,15 @@ i32 WyncTrack_prop_register_minimal (
 	prop->prop_type = data_type;
 	prop->enabled = true;
 
+	ctx->co_track.prop_flags[prop_id] = 0;
+	WyncTrack_prop_update_hot_flags(ctx, prop_id);
+
 	// initialize statebff
 	// TODO: some might not be necessary for all
 
-	prop->statebff.last_ticks_received = i32_RinBuf_create
-		(ctx->co_track.REGULAR_PROP_CACHED_STATE_AMOUNT, -1);
-
-	// TODO: Dynamic sized buffer for all owned predicted props?
-	// TODO: Only do this if this prop is predicted, move to prop_set_predict ?
-
-	size_t saved_states_size;
-
-	if (data_type == WYNC_PROP_TYPE_INPUT || data_type == WYNC_PROP_TYPE_EVENT) {
-		saved_states_size = INPUT_BUFFER_SIZE;
-	} else {
-		saved_states_size = ctx->co_track.REGULAR_PROP_CACHED_STATE_AMOUNT;
-	}
+	// grows once interpolation, prediction or timewarp are enabled
 
-	prop->statebff.saved_states = WyncState_RinBuf_create
-		(saved_states_size, (WyncState){ 0 });
-	prop->statebff.state_id_to_tick = i32_RinBuf_create
-		(saved_states_size, -1);
-	prop->statebff.tick_to_state_id = i32_RinBuf_create
-		(saved_states_size, -1);
-	prop->statebff.state_id_to_local_tick = i32_RinBuf_create
-		(saved_states_size, -1); // only for lerp
+	WyncProp_history_create(ctx, prop);
 
 	// mark new Prop as active
 
@@ -165,6 +150,7 @@ i32 WyncTrack_prop_register_minimal (
 	assert(error == OK);
 
 	u32_DynArr_insert(entity_props, prop_id);
+	ctx->co_track.prop_entity_id[prop_id] = entity_id;
 
 	ctx->common.was_any_prop_added_deleted = true;
 
@@ -174,6 +160,62 @@ i32 WyncTrack_prop_register_minimal (
 }
 
 
+/// Same as WyncTrack_prop_register_minimal but with a declared upper bound
+/// for the state size, the state history is backed by a preallocated slab.
+///
+/// @param[out] out_prop_id
+/// @returns error
+i32 WyncTrack_prop_register_sized (
+	WyncCtx *ctx,
+	u32 entity_id,
+	const char* name_id,
+	enum WYNC_PROP_TYPE data_type,
+	u32 max_data_size,
+	u32 *out_prop_id
+) {
+	if (max_data_size == 0) {
+		return -1;
+	}
+
+	u32 prop_id;
+	i32 err = WyncTrack_prop_register_minimal(
+		ctx, entity_id, name_id, data_type, &prop_id);
+	if (err != OK) {
+		return -1;
+	}
+
+	WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
+	prop->declared_data_size = max_data_size;
+	WyncStore_prop_state_buffer_use_slab(prop, max_data_size);
+	WyncWrapper_batch_assign_prop(ctx, prop_id, entity_id);
+
+	*out_prop_id = prop_id;
+	return OK;
+}
+
+
+/// Mirrors the prop's cold configuration into the hot parallel arrays.
+/// Call after changing any of the prop's flags.
+void WyncTrack_prop_update_hot_flags(WyncCtx *ctx, u32 prop_id) {
+	WyncProp *prop = &ctx->co_track.props[prop_id];
+
+	// runtime-only flags are kept
+	u16 flags = ctx->co_track.prop_flags[prop_id]
+		& WYNC_PROP_FLAG_JUST_RECEIVED_NEW_STATE;
+
+	if (prop->enabled)                 flags |= WYNC_PROP_FLAG_ENABLED;
+	if (prop->lerp_enabled)            flags |= WYNC_PROP_FLAG_LERP;
+	if (prop->xtrap_enabled)           flags |= WYNC_PROP_FLAG_XTRAP;
+	if (prop->relative_sync_enabled)   flags |= WYNC_PROP_FLAG_RELATIVE_SYNC;
+	if (prop->consumed_events_enabled) flags |= WYNC_PROP_FLAG_CONSUMED_EVENTS;
+	if (prop->timewarp_enabled)        flags |= WYNC_PROP_FLAG_TIMEWARP;
+	if (prop->is_auxiliar_prop)        flags |= WYNC_PROP_FLAG_AUXILIAR;
+
+	ctx->co_track.prop_flags[prop_id] = flags;
+	ctx->co_track.prop_type[prop_id] = (u8)prop->prop_type;
+}
+
+
 WyncProp *WyncTrack_get_prop(WyncCtx *ctx, u32 prop_id);
 
 
@@ -255,35 +297,12 @@ i32 WyncTrack_prop_get_entity(
 	u32 prop_id,
 	u32 *out_entity_id
 ) {
-	ConMap *tracked_entities = &ctx->co_track.tracked_entities;
-    ConMapIterator it = { 0 };
-    u32 entity_id;
-	i32 err;
-
-	// iterate all entities (slow)
-
-    while (ConMap_iterator_get_next_key(tracked_entities, &it) == OK) {
-		entity_id = it.key;
-
-		u32_DynArr *entity_props = NULL;
-		err = u32_DynArr_ConMap_get
-			(&ctx->co_track.entity_has_props, entity_id, &entity_props);
-		assert(err == OK);
-
-		// iterate entity props
-
-		u32_DynArrIterator dyna_it = { 0 };
-		while (u32_DynArr_iterator_get_next(entity_props, &dyna_it) == OK) {
-			u32 here_prop_id = *dyna_it.item;
-
-			if (here_prop_id == prop_id) {
-				*out_entity_id = entity_id;
-				return OK;
-			}
-		}
+	if (prop_id >= MAX_PROPS
+		|| ctx->co_track.prop_entity_id[prop_id] == (u32)-1) {
+		return -1;
 	}
-
-	return -1;
+	*out_entity_id = ctx->co_track.prop_entity_id[prop_id];
+	return OK;
 }
 
 
@@ -299,7 +318,7 @@ bool WyncTrack_is_entity_tracked (
 /// @retval NULL Not found / Not enabled
 WyncProp *WyncTrack_get_prop(WyncCtx *ctx, u32 prop_id) {
 	if ( prop_id < MAX_PROPS
-		&& ctx->co_track.props[prop_id].enabled
+		&& (ctx->co_track.prop_flags[prop_id] & WYNC_PROP_FLAG_ENABLED)
 	) {
 		return &ctx->co_track.props[prop_id];
 	};
@@ -32,6 +32,9 @@ typedef struct{
 
 #define WYNC_MAX_USER_TYPES 256
 #define WYNC_MAX_BLUEPRINTS 64
+// Capacity given to WyncWrapper_GetterInto when the prop has no slab
+#define WYNC_GETTER_SCRATCH_SIZE 4096
+#define WYNC_MAX_BATCHES 32
 
 //typedef struct {
 	//u32 data_size;
@@ -62,21 +65,83 @@ inline static void WyncWrapper_Data_free(WyncWrapper_Data data) {
 // ^^^ FUTURE: A method with less indirections using void* with prefixed size
 
 
+typedef struct {
+	u32 entity_type_id;
+	char prop_name[64];
+	WyncWrapper_BatchGetter getter;
+	WyncWrapper_BatchSetter setter;
+
+	// (server-side) batched extractable props, rebuilt with the prop filters
+	u32_DynArr prop_ids;
+
+	// Scratch arrays passed to the callbacks, 'scratch_capacity' items each
+	u32 scratch_capacity;
+	u32 pending_setter_amount;
+	u32 *scratch_prop_ids;
+	WyncWrapper_UserCtx *scratch_user_ctxs;
+	void **scratch_dsts;
+	u32 *scratch_sizes;
+	WyncWrapper_Data *scratch_datas;
+
+	// Copies of queued states, see WyncWrapper_set_prop_state_copy
+	char *scratch_bytes;
+	u32 scratch_bytes_used;
+	u32 scratch_bytes_capacity;
+} WyncWrapper_Batch;
+
+
+// Interpolated props of a lerp type, lerped together by it's kernel and
+// handed to it's batch setter. Reused every frame
+typedef struct {
+	WyncWrapper_BatchSetter setter;
+	u32 amount;
+	u32 stride; // state size shared by every prop in the batch
+
+	u32 capacity;       // props
+	u32 bytes_capacity; // of 'lefts', 'rights' and 'outs'
+	char *lefts;
+	char *rights;
+	char *outs;
+	float *factors;
+	WyncWrapper_UserCtx *user_ctxs;
+	WyncWrapper_Data *datas;
+} WyncWrapper_LerpBatch;
+
+
 typedef struct WyncWrapperCtx{
 	WyncWrapper_UserCtx prop_user_ctx[MAX_PROPS];
 	WyncWrapper_Getter prop_getter[MAX_PROPS];
+	WyncWrapper_GetterInto prop_getter_into[MAX_PROPS]; // preferred if set
 	WyncWrapper_Setter prop_setter[MAX_PROPS]; // Maybe use a b-tree set?
 	WyncWrapper_Setter prop_setter_lerp[MAX_PROPS]; // Maybe use a b-tree set?
+	WyncWrapper_DistanceFunc prop_pred_distance[MAX_PROPS]; // optional
 
 	// Array<user_type_id: int, Any>
 	// use lerp_function[index] directly
 	//u16 lerp_type_to_lerp_function[WYNC_MAX_USER_TYPES];
 	WyncWrapper_LerpFunc lerp_function[WYNC_MAX_USER_TYPES];
+	// Array<user_type_id: int, enum WYNC_LERP_KERNEL>, preferred if set
+	u8 lerp_kernel[WYNC_MAX_USER_TYPES];
+	// Kernel output handed to the lerp setters
+	char lerp_scratch[WYNC_GETTER_SCRATCH_SIZE];
+	WyncWrapper_LerpBatch lerp_batches[WYNC_MAX_USER_TYPES];
+	// user type ids with props pending in 'lerp_batches' this frame
+	u16 lerp_batch_pending_types[WYNC_MAX_USER_TYPES];
+	u32 lerp_batch_pending_amount;
 
 	// Array<delta_blueprint_id: int, Blueprint>
 	WyncWrapper_DeltaBlueprint delta_blueprints[WYNC_MAX_BLUEPRINTS];
 	uint delta_blueprint_id_counter;
 
+	WyncWrapper_Batch batches[WYNC_MAX_BATCHES];
+	u32 batch_amount;
+	// Array<prop_id: int, batch index + 1>. 0 if not batched
+	u8 prop_batch_id[MAX_PROPS];
+
+	// Destination for WyncWrapper_GetterInto when there's no history slot
+	// to write into
+	char getter_scratch[WYNC_GETTER_SCRATCH_SIZE];
+
 	// TODO(Future): Physics integration functions
 	//// Maybe this is the user's responsibility
 	//// Map<entity_id: int, sim_fun_id>
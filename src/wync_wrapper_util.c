@@ -15,9 +15,347 @@ void WyncWrapper_set_prop_callbacks(
 ) {
 	ctx->wrapper->prop_user_ctx[prop_id] = user_ctx;
 	ctx->wrapper->prop_getter[prop_id] = getter;
+	ctx->wrapper->prop_getter_into[prop_id] = NULL;
 	ctx->wrapper->prop_setter[prop_id] = setter;
 }
 
+void WyncWrapper_set_prop_callbacks_into(
+	WyncCtx *ctx,
+	u32 prop_id,
+	WyncWrapper_UserCtx user_ctx,
+	WyncWrapper_GetterInto getter_into,
+	WyncWrapper_Setter setter
+) {
+	ctx->wrapper->prop_user_ctx[prop_id] = user_ctx;
+	ctx->wrapper->prop_getter[prop_id] = NULL;
+	ctx->wrapper->prop_getter_into[prop_id] = getter_into;
+	ctx->wrapper->prop_setter[prop_id] = setter;
+}
+
+// Batch callbacks
+// ==================================================
+
+static void WyncWrapper_batch_reserve(WyncWrapper_Batch *batch, u32 amount) {
+	if (amount <= batch->scratch_capacity) {
+		return;
+	}
+	u32 capacity = MAX(amount, batch->scratch_capacity * 2);
+	batch->scratch_prop_ids = (u32*) realloc(
+		batch->scratch_prop_ids, sizeof(u32) * capacity);
+	batch->scratch_user_ctxs = (WyncWrapper_UserCtx*) realloc(
+		batch->scratch_user_ctxs, sizeof(WyncWrapper_UserCtx) * capacity);
+	batch->scratch_dsts = (void**) realloc(
+		batch->scratch_dsts, sizeof(void*) * capacity);
+	batch->scratch_sizes = (u32*) realloc(
+		batch->scratch_sizes, sizeof(u32) * capacity);
+	batch->scratch_datas = (WyncWrapper_Data*) realloc(
+		batch->scratch_datas, sizeof(WyncWrapper_Data) * capacity);
+	batch->scratch_capacity = capacity;
+}
+
+/// Queued datas pointing into the previous buffer are moved along
+static void WyncWrapper_batch_reserve_bytes(WyncWrapper_Batch *batch, u32 size) {
+	if (size <= batch->scratch_bytes_capacity) {
+		return;
+	}
+	u32 capacity = MAX(size, batch->scratch_bytes_capacity * 2);
+	char *bytes = (char*) malloc(capacity);
+	char *prev = batch->scratch_bytes;
+	if (prev != NULL) {
+		memcpy(bytes, prev, batch->scratch_bytes_used);
+		for (u32 i = 0; i < batch->pending_setter_amount; ++i) {
+			char *data = (char*)batch->scratch_datas[i].data;
+			if (data >= prev && data < prev + batch->scratch_bytes_used) {
+				batch->scratch_datas[i].data = bytes + (data - prev);
+			}
+		}
+	}
+	free(prev);
+	batch->scratch_bytes = bytes;
+	batch->scratch_bytes_capacity = capacity;
+}
+
+/// @returns Optional batch
+static WyncWrapper_Batch *WyncWrapper_get_prop_batch(WyncCtx *ctx, u32 prop_id) {
+	u8 batch_id = ctx->wrapper->prop_batch_id[prop_id];
+	if (batch_id == 0) {
+		return NULL;
+	}
+	return &ctx->wrapper->batches[batch_id -1];
+}
+
+/// @returns error
+i32 WyncWrapper_register_batch_callbacks(
+	WyncCtx *ctx,
+	u32 entity_type_id,
+	const char *prop_name,
+	WyncWrapper_BatchGetter getter,
+	WyncWrapper_BatchSetter setter
+) {
+	WyncWrapperCtx *wrapper = ctx->wrapper;
+	if (wrapper->batch_amount >= WYNC_MAX_BATCHES) {
+		LOG_ERR_C(ctx, "Reached max amount of batches (%u)", WYNC_MAX_BATCHES);
+		return -1;
+	}
+	if (strlen(prop_name) >= sizeof(wrapper->batches[0].prop_name)) {
+		return -2;
+	}
+
+	u32 batch_idx = wrapper->batch_amount++;
+	WyncWrapper_Batch *batch = &wrapper->batches[batch_idx];
+	*batch = (WyncWrapper_Batch) { 0 };
+	batch->entity_type_id = entity_type_id;
+	strcpy(batch->prop_name, prop_name);
+	batch->getter = getter;
+	batch->setter = setter;
+	batch->prop_ids = u32_DynArr_create();
+
+	// assign already registered props
+
+	ConMapIterator it = { 0 };
+	while (ConMap_iterator_get_next_key(
+		&ctx->co_track.tracked_entities, &it) == OK)
+	{
+		u32 entity_id = it.key;
+		u32_DynArr *entity_props = NULL;
+		if (u32_DynArr_ConMap_get(
+			&ctx->co_track.entity_has_props, entity_id, &entity_props) != OK) {
+			continue;
+		}
+		u32_DynArrIterator prop_it = { 0 };
+		while (u32_DynArr_iterator_get_next(entity_props, &prop_it) == OK) {
+			WyncWrapper_batch_assign_prop(ctx, *prop_it.item, entity_id);
+		}
+	}
+
+	ctx->common.was_any_prop_added_deleted = true;
+	return OK;
+}
+
+/// Links the prop to the batch matching it's entity type and name, if any
+void WyncWrapper_batch_assign_prop(WyncCtx *ctx, u32 prop_id, u32 entity_id) {
+	WyncWrapperCtx *wrapper = ctx->wrapper;
+	WyncProp *prop = WyncTrack_get_prop(ctx, prop_id);
+	if (prop == NULL || prop->declared_data_size == 0) {
+		return;
+	}
+
+	int entity_type_id = -1;
+	if (ConMap_get(
+		&ctx->co_track.entity_is_of_type, entity_id, &entity_type_id) != OK) {
+		return;
+	}
+
+	for (u32 i = 0; i < wrapper->batch_amount; ++i) {
+		WyncWrapper_Batch *batch = &wrapper->batches[i];
+		if (batch->entity_type_id != (u32)entity_type_id) continue;
+		if (strcmp(batch->prop_name, prop->name_id) != 0) continue;
+
+		wrapper->prop_batch_id[prop_id] = (u8)(i +1);
+		return;
+	}
+}
+
+/// Extracts a batch of slab backed props into their history at 'tick'
+static void WyncWrapper_extract_batch_to_tick(
+	WyncCtx *ctx,
+	WyncWrapper_Batch *batch,
+	u32 *prop_ids,
+	u32 prop_amount,
+	i32 tick
+) {
+	if (batch->getter == NULL || prop_amount == 0) {
+		return;
+	}
+	WyncWrapper_batch_reserve(batch, prop_amount);
+
+	u32 amount = 0;
+	for (u32 i = 0; i < prop_amount; ++i) {
+		u32 prop_id = prop_ids[i];
+		WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
+
+		u32 capacity = 0;
+		char *slot = WyncStore_prop_state_buffer_next_slot(prop, &capacity);
+		if (slot == NULL) continue;
+
+		batch->scratch_prop_ids[amount] = prop_id;
+		batch->scratch_user_ctxs[amount] = ctx->wrapper->prop_user_ctx[prop_id];
+		batch->scratch_dsts[amount] = slot;
+		batch->scratch_sizes[amount] = capacity;
+		++amount;
+	}
+
+	batch->getter(batch->scratch_user_ctxs, batch->scratch_dsts,
+		batch->scratch_sizes, amount);
+
+	for (u32 i = 0; i < amount; ++i) {
+		WyncProp *prop = WyncTrack_get_prop_unsafe(
+			ctx, batch->scratch_prop_ids[i]);
+		WyncStore_prop_state_buffer_commit_slot(
+			ctx, prop, tick, batch->scratch_sizes[i]);
+	}
+}
+
+/// Sets the prop's state through it's setter. Batched props are queued until
+/// WyncWrapper_flush_batch_setters, 'state' must remain valid until then.
+void WyncWrapper_set_prop_state(WyncCtx *ctx, u32 prop_id, WyncState state) {
+	WyncWrapper_Batch *batch = WyncWrapper_get_prop_batch(ctx, prop_id);
+	if (batch != NULL && batch->setter != NULL) {
+		WyncWrapper_batch_reserve(batch, batch->pending_setter_amount +1);
+		u32 i = batch->pending_setter_amount++;
+		batch->scratch_user_ctxs[i] = ctx->wrapper->prop_user_ctx[prop_id];
+		batch->scratch_datas[i] =
+			(WyncWrapper_Data) { state.data_size, state.data };
+		return;
+	}
+
+	WyncWrapper_Setter setter = ctx->wrapper->prop_setter[prop_id];
+	if (setter == NULL) return;
+	setter(ctx->wrapper->prop_user_ctx[prop_id],
+		(WyncWrapper_Data){ state.data_size, state.data });
+}
+
+/// Same as WyncWrapper_set_prop_state, batched props queue a copy of 'state'
+/// so it doesn't need to outlive the call
+void WyncWrapper_set_prop_state_copy(WyncCtx *ctx, u32 prop_id, WyncState state) {
+	WyncWrapper_Batch *batch = WyncWrapper_get_prop_batch(ctx, prop_id);
+	if (batch == NULL || batch->setter == NULL) {
+		WyncWrapper_set_prop_state(ctx, prop_id, state);
+		return;
+	}
+	WyncWrapper_batch_reserve_bytes(
+		batch, batch->scratch_bytes_used + state.data_size);
+	char *data = batch->scratch_bytes + batch->scratch_bytes_used;
+	memcpy(data, state.data, state.data_size);
+	batch->scratch_bytes_used += state.data_size;
+	WyncWrapper_set_prop_state(ctx, prop_id, (WyncState) { state.data_size, data });
+}
+
+/// @returns Whether the prop can be set, by it's own or a batch setter
+bool WyncWrapper_prop_has_setter(WyncCtx *ctx, u32 prop_id) {
+	if (ctx->wrapper->prop_setter[prop_id] != NULL) {
+		return true;
+	}
+	WyncWrapper_Batch *batch = WyncWrapper_get_prop_batch(ctx, prop_id);
+	return batch != NULL && batch->setter != NULL;
+}
+
+void WyncWrapper_flush_batch_setters(WyncCtx *ctx) {
+	for (u32 i = 0; i < ctx->wrapper->batch_amount; ++i) {
+		WyncWrapper_Batch *batch = &ctx->wrapper->batches[i];
+		if (batch->pending_setter_amount == 0) continue;
+
+		batch->setter(batch->scratch_user_ctxs, batch->scratch_datas,
+			batch->pending_setter_amount);
+		batch->pending_setter_amount = 0;
+		batch->scratch_bytes_used = 0;
+	}
+}
+
+/// Extracts the prop's current state into it's history at 'tick'.
+/// With a WyncWrapper_GetterInto and a prop of declared size the state is
+/// written directly into the history slab, no allocations involved.
+///
+/// @returns error
+i32 WyncWrapper_extract_prop_to_tick(WyncCtx *ctx, u32 prop_id, i32 tick) {
+	WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
+	WyncWrapper_UserCtx user_ctx = ctx->wrapper->prop_user_ctx[prop_id];
+	WyncWrapper_GetterInto getter_into = ctx->wrapper->prop_getter_into[prop_id];
+
+	if (getter_into != NULL) {
+
+		// a slab adopted from the first state might be outgrown, only props
+		// with a declared size are written in place
+
+		u32 capacity = 0;
+		char *slot = prop->declared_data_size > 0 ?
+			WyncStore_prop_state_buffer_next_slot(prop, &capacity) : NULL;
+		if (slot != NULL) {
+			u32 written = getter_into(user_ctx, slot, capacity);
+			if (written > 0 && written <= capacity) {
+				return WyncStore_prop_state_buffer_commit_slot(
+					ctx, prop, tick, written);
+			}
+		}
+
+		u32 written = getter_into(
+			user_ctx, ctx->wrapper->getter_scratch, WYNC_GETTER_SCRATCH_SIZE);
+		if (written == 0 || written > WYNC_GETTER_SCRATCH_SIZE) {
+			return -1;
+		}
+		WyncStore_prop_state_buffer_insert_copy(
+			ctx, prop, tick, written, ctx->wrapper->getter_scratch);
+		return OK;
+	}
+
+	WyncWrapper_Getter getter = ctx->wrapper->prop_getter[prop_id];
+	if (getter == NULL) {
+		WyncWrapper_Batch *batch = WyncWrapper_get_prop_batch(ctx, prop_id);
+		if (batch == NULL) {
+			return -1;
+		}
+		WyncWrapper_extract_batch_to_tick(ctx, batch, &prop_id, 1, tick);
+		return OK;
+	}
+	WyncWrapper_Data data = getter(user_ctx);
+	WyncStore_prop_state_buffer_insert(
+		ctx, prop, tick, (WyncState){data.data_size, data.data});
+	return OK;
+}
+
+/// Reads the prop's current state without storing it.
+/// Unless 'out_must_free' the state is only valid until the next call.
+///
+/// @param[out] out_state
+/// @param[out] out_must_free Whether the caller owns 'out_state'
+/// @returns error
+i32 WyncWrapper_get_prop_state_shared(
+	WyncCtx *ctx,
+	u32 prop_id,
+	WyncState *out_state,
+	bool *out_must_free
+) {
+	WyncWrapper_UserCtx user_ctx = ctx->wrapper->prop_user_ctx[prop_id];
+	WyncWrapper_GetterInto getter_into = ctx->wrapper->prop_getter_into[prop_id];
+	WyncWrapper_Getter getter = ctx->wrapper->prop_getter[prop_id];
+
+	if (getter_into != NULL) {
+		u32 written = getter_into(
+			user_ctx, ctx->wrapper->getter_scratch, WYNC_GETTER_SCRATCH_SIZE);
+		if (written == 0 || written > WYNC_GETTER_SCRATCH_SIZE) {
+			return -1;
+		}
+		*out_state = (WyncState) { written, ctx->wrapper->getter_scratch };
+		*out_must_free = false;
+		return OK;
+	}
+	if (getter == NULL) {
+		WyncWrapper_Batch *batch = WyncWrapper_get_prop_batch(ctx, prop_id);
+		if (batch == NULL || batch->getter == NULL) {
+			return -1;
+		}
+
+		// batch of one
+		void *dst = ctx->wrapper->getter_scratch;
+		u32 written = WYNC_GETTER_SCRATCH_SIZE;
+		batch->getter(&user_ctx, &dst, &written, 1);
+		if (written == 0 || written > WYNC_GETTER_SCRATCH_SIZE) {
+			return -1;
+		}
+		*out_state = (WyncState) { written, ctx->wrapper->getter_scratch };
+		*out_must_free = false;
+		return OK;
+	}
+
+	WyncWrapper_Data data = getter(user_ctx);
+	*out_state = (WyncState) { data.data_size, data.data };
+	*out_must_free = true;
+	if (data.data_size == 0 || data.data == NULL) {
+		return -2;
+	}
+	return OK;
+}
+
 // ==================================================
 // Wrapper functions that aren't worth creating a 
 // wrapper version of their respective modules
@@ -31,23 +369,12 @@ void WyncWrapper_buffer_inputs(WyncCtx *ctx) {
 		&ctx->co_filter_c.type_input_event__owned_prop_ids, &it) == OK)
 	{
 		u32 prop_id = *it.item;
-		WyncProp *input_prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
-		WyncWrapper_UserCtx user_ctx = ctx->wrapper->prop_user_ctx[prop_id];
-		WyncWrapper_Getter getter = ctx->wrapper->prop_getter[prop_id];
-
-		WyncWrapper_Data new_state = getter(user_ctx);
-
-		WyncStore_prop_state_buffer_insert(
-				ctx, input_prop, ctx->co_pred.target_tick,
-				(WyncState) {new_state.data_size, new_state.data});
+		WyncWrapper_extract_prop_to_tick(ctx, prop_id, ctx->co_pred.target_tick);
 	}
 }
 
 void WyncWrapper_extract_data_to_tick(WyncCtx *ctx, u32 save_on_tick) {
 	WyncProp *prop = NULL;
-	WyncProp *prop_aux = NULL;
-	WyncWrapper_Getter *getter = NULL;
-	WyncWrapper_UserCtx *user_ctx = NULL;
 
 	// save state history per tick
 
@@ -55,16 +382,15 @@ void WyncWrapper_extract_data_to_tick(WyncCtx *ctx, u32 save_on_tick) {
 	while(u32_DynArr_iterator_get_next(
 		&ctx->co_filter_s.filtered_regular_extractable_prop_ids, &it) == OK) {
 		u32 prop_id = *it.item;
+		WyncWrapper_Batch *batch = WyncWrapper_get_prop_batch(ctx, prop_id);
+		if (batch != NULL && batch->getter != NULL) continue;
+		WyncWrapper_extract_prop_to_tick(ctx, prop_id, save_on_tick);
+	}
 
-		prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
-		getter = &ctx->wrapper->prop_getter[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-
-		if (*getter == NULL) continue;
-		WyncWrapper_Data data = (*getter)(*user_ctx);
-
-		WyncStore_prop_state_buffer_insert(
-			ctx, prop, save_on_tick, (WyncState){data.data_size, data.data});
+	for (u32 i = 0; i < ctx->wrapper->batch_amount; ++i) {
+		WyncWrapper_Batch *batch = &ctx->wrapper->batches[i];
+		WyncWrapper_extract_batch_to_tick(ctx, batch,
+			batch->prop_ids.items, (u32)batch->prop_ids.size, save_on_tick);
 	}
 
 	// extracts events ids (from auxiliar props)
@@ -75,17 +401,8 @@ void WyncWrapper_extract_data_to_tick(WyncCtx *ctx, u32 save_on_tick) {
 		u32 prop_id = *it.item;
 
 		prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
-		prop_aux = WyncTrack_get_prop_unsafe(
-									ctx, prop->auxiliar_delta_events_prop_id);
-
-		getter = &ctx->wrapper->prop_getter[prop->auxiliar_delta_events_prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop->auxiliar_delta_events_prop_id];
-
-		if (*getter == NULL) continue;
-		WyncWrapper_Data data = (*getter)(*user_ctx);
-
-		WyncStore_prop_state_buffer_insert(
-			ctx, prop_aux, save_on_tick, (WyncState){data.data_size, data.data});
+		WyncWrapper_extract_prop_to_tick(
+			ctx, prop->auxiliar_delta_events_prop_id, save_on_tick);
 	}
 }
 
@@ -104,8 +421,14 @@ void WyncWrapper_server_filter_prop_ids(WyncCtx *ctx) {
 		&ctx->co_filter_s.filtered_regular_extractable_prop_ids);
 	u32_DynArr_clear_preserving_capacity(
 		&ctx->co_filter_s.filtered_regular_timewarpable_prop_ids);
+	for (u32 i = 0; i < ctx->wrapper->batch_amount; ++i) {
+		u32_DynArr_clear_preserving_capacity(&ctx->wrapper->batches[i].prop_ids);
+	}
 
-	WyncProp *prop = NULL;
+	// Note: only the hot prop arrays are read here
+
+	u16 *prop_flags = ctx->co_track.prop_flags;
+	u8 *prop_type = ctx->co_track.prop_type;
 
 	u32 peer_amount = (u32)i32_DynArr_get_size(&ctx->common.peers);
 	for (u16 client_id = 1; client_id < peer_amount; ++client_id) {
@@ -115,9 +438,8 @@ void WyncWrapper_server_filter_prop_ids(WyncCtx *ctx) {
 			&ctx->co_clientauth.client_owns_prop[client_id], &it) == OK)
 		{
 			u32 prop_id = it.key;
-			prop = WyncTrack_get_prop(ctx, prop_id);
-			if (prop->prop_type != WYNC_PROP_TYPE_INPUT &&
-			    prop->prop_type != WYNC_PROP_TYPE_EVENT) {
+			if (prop_type[prop_id] != WYNC_PROP_TYPE_INPUT &&
+			    prop_type[prop_id] != WYNC_PROP_TYPE_EVENT) {
 				continue;
 			}
 			
@@ -131,31 +453,36 @@ void WyncWrapper_server_filter_prop_ids(WyncCtx *ctx) {
 		&ctx->co_track.active_prop_ids, &it) == OK)
 	{
 		u32 prop_id = it.key;
-		prop = WyncTrack_get_prop(ctx, prop_id);
+		u16 flags = prop_flags[prop_id];
 
-		if (prop->prop_type != WYNC_PROP_TYPE_STATE &&
-			prop->prop_type != WYNC_PROP_TYPE_INPUT) {
+		if (prop_type[prop_id] != WYNC_PROP_TYPE_STATE &&
+			prop_type[prop_id] != WYNC_PROP_TYPE_INPUT) {
 			continue;
 		}
 
-		if (prop->relative_sync_enabled &&
-			prop->prop_type == WYNC_PROP_TYPE_STATE
+		if ((flags & WYNC_PROP_FLAG_RELATIVE_SYNC) &&
+			prop_type[prop_id] == WYNC_PROP_TYPE_STATE
 		) {
 			u32_DynArr_insert(
 				&ctx->co_filter_s.filtered_delta_prop_ids, prop_id);
 			continue;
 		}
 
-		if (prop->prop_type == WYNC_PROP_TYPE_STATE) {
+		if (prop_type[prop_id] == WYNC_PROP_TYPE_STATE) {
 			u32_DynArr_insert(
 				&ctx->co_filter_s.filtered_regular_extractable_prop_ids, prop_id);
+
+			WyncWrapper_Batch *batch = WyncWrapper_get_prop_batch(ctx, prop_id);
+			if (batch != NULL) {
+				u32_DynArr_insert(&batch->prop_ids, prop_id);
+			}
 		}
 
-		if (prop->timewarp_enabled) {
+		if (flags & WYNC_PROP_FLAG_TIMEWARP) {
 			u32_DynArr_insert(
 				&ctx->co_filter_s.filtered_regular_timewarpable_prop_ids, prop_id);
 
-			if (prop->lerp_enabled) {
+			if (flags & WYNC_PROP_FLAG_LERP) {
 				u32_DynArr_insert
 					(&ctx->co_filter_s.filtered_regular_timewarpable_interpolable_prop_ids, prop_id);
 			}
@@ -167,6 +494,92 @@ void WyncWrapper_server_filter_prop_ids(WyncCtx *ctx) {
 	}
 }
 
+/// Caches the props of every predicted entity into flat lists so the
+/// prediction loop doesn't look them up per tick
+static void WyncWrapper_client_cache_predicted_entity_props (WyncCtx *ctx) {
+	CoPredictionData *co_pred = &ctx->co_pred;
+	u16 *prop_flags = ctx->co_track.prop_flags;
+	ConMap *owned_props =
+		&ctx->co_clientauth.client_owns_prop[ctx->common.my_peer_id];
+
+	ConMap_clear_preserve_capacity(&co_pred->predicted_entity_index);
+	u32_DynArr_clear_preserving_capacity(&co_pred->predicted_xtrap_prop_ids);
+	u32_DynArr_clear_preserving_capacity(&co_pred->predicted_xtrap_prop_offsets);
+	u32_DynArr_clear_preserving_capacity(&co_pred->predicted_received_prop_ids);
+	u32_DynArr_clear_preserving_capacity(
+		&co_pred->predicted_received_prop_offsets);
+
+	u32 entity_amount = (u32)co_pred->predicted_entity_ids.size;
+	if (entity_amount > co_pred->entity_min_ticks_capacity) {
+		co_pred->entity_min_ticks = (WyncXtrap_EntityMinTick*) realloc(
+			co_pred->entity_min_ticks,
+			sizeof(WyncXtrap_EntityMinTick) * entity_amount);
+		co_pred->entity_min_ticks_capacity = entity_amount;
+	}
+
+	u32_DynArrIterator it = { 0 };
+	while (u32_DynArr_iterator_get_next(
+		&co_pred->predicted_entity_ids, &it) == OK)
+	{
+		u32 entity_id = *it.item;
+		ConMap_set_pair(&co_pred->predicted_entity_index, entity_id, it.index);
+		u32_DynArr_insert(&co_pred->predicted_xtrap_prop_offsets,
+			(u32)co_pred->predicted_xtrap_prop_ids.size);
+		u32_DynArr_insert(&co_pred->predicted_received_prop_offsets,
+			(u32)co_pred->predicted_received_prop_ids.size);
+
+		// entity indices changed, reseed the min over it's props
+
+		WyncXtrap_EntityMinTick *min = &co_pred->entity_min_ticks[it.index];
+		*min = (WyncXtrap_EntityMinTick) { -1, 0 };
+
+		u32_DynArr *entity_props = NULL;
+		i32 err = u32_DynArr_ConMap_get(
+			&ctx->co_track.entity_has_props, entity_id, &entity_props);
+		if (err != OK) { continue; }
+
+		u32_DynArrIterator prop_it = { 0 };
+		while (u32_DynArr_iterator_get_next(entity_props, &prop_it) == OK) {
+			u32 prop_id = *prop_it.item;
+			if (prop_id >= MAX_PROPS) { continue; }
+			u16 flags = prop_flags[prop_id];
+			if (flags & WYNC_PROP_FLAG_RELATIVE_SYNC) { continue; }
+
+			if (flags & WYNC_PROP_FLAG_XTRAP) {
+				u32_DynArr_insert(&co_pred->predicted_xtrap_prop_ids, prop_id);
+			}
+			if (ConMap_has_key(owned_props, prop_id)) { continue; }
+			u32_DynArr_insert(&co_pred->predicted_received_prop_ids, prop_id);
+
+			// state might have arrived before the entity was predicted
+
+			WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
+			i32 prop_last_tick = *i32_RinBuf_get_relative(
+				&prop->statebff.last_ticks_received, 0);
+			if (prop_last_tick == -1) { continue; }
+
+			if (min->tick == -1 || prop_last_tick < min->tick) {
+				*min = (WyncXtrap_EntityMinTick) { prop_last_tick, 1 };
+			} else if (prop_last_tick == min->tick) {
+				++min->props_at_tick;
+			}
+		}
+		if (min->tick != -1) {
+			ConMap_set_pair(
+				&co_pred->entity_last_received_tick, entity_id, min->tick);
+		}
+	}
+
+	// closing offsets
+
+	u32_DynArr_insert(&co_pred->predicted_xtrap_prop_offsets,
+		(u32)co_pred->predicted_xtrap_prop_ids.size);
+	u32_DynArr_insert(&co_pred->predicted_received_prop_offsets,
+		(u32)co_pred->predicted_received_prop_ids.size);
+
+}
+
+
 void WyncWrapper_client_filter_prop_ids (WyncCtx *ctx) {
 	if (!ctx->common.was_any_prop_added_deleted) return;
 	ctx->common.was_any_prop_added_deleted = false;
@@ -193,22 +606,26 @@ void WyncWrapper_client_filter_prop_ids (WyncCtx *ctx) {
 
 	// Note: Consider drop concept of 'active' props, they're the same?
 
-	WyncProp *prop;
+	// Note: only the hot prop arrays are read here
+
+	u16 *prop_flags = ctx->co_track.prop_flags;
+	u8 *prop_type = ctx->co_track.prop_type;
 	ConMapIterator it = { 0 };
 
 	while (ConMap_iterator_get_next_key(
 		&ctx->co_clientauth.client_owns_prop[ctx->common.my_peer_id], &it) == OK)
 	{
 		u32 prop_id = it.key;
-		prop = WyncTrack_get_prop(ctx, prop_id);
-		if (prop == NULL) continue;
+		if (prop_id >= MAX_PROPS) continue;
+		u16 flags = prop_flags[prop_id];
+		if (!(flags & WYNC_PROP_FLAG_ENABLED)) continue;
 
-		if (prop->prop_type == WYNC_PROP_TYPE_STATE) continue;
+		if (prop_type[prop_id] == WYNC_PROP_TYPE_STATE) continue;
 
 		u32_DynArr_insert(
 			&ctx->co_filter_c.type_input_event__owned_prop_ids, prop_id);
 
-		if (prop->xtrap_enabled) {
+		if (flags & WYNC_PROP_FLAG_XTRAP) {
 			u32_DynArr_insert(
 				&ctx->co_filter_c.type_input_event__predicted_owned_prop_ids, prop_id);
 		}
@@ -220,29 +637,30 @@ void WyncWrapper_client_filter_prop_ids (WyncCtx *ctx) {
 		&ctx->co_track.active_prop_ids, &it) == OK)
 	{
 		u32 prop_id = it.key;
-		prop = WyncTrack_get_prop(ctx, prop_id);
+		u16 flags = prop_flags[prop_id];
 
-		if (prop->prop_type == WYNC_PROP_TYPE_EVENT && prop->xtrap_enabled) {
+		if (prop_type[prop_id] == WYNC_PROP_TYPE_EVENT
+			&& (flags & WYNC_PROP_FLAG_XTRAP)) {
 			u32_DynArr_insert(
 				&ctx->co_filter_c.type_event__predicted_prop_ids, prop_id);
 		}
 
-		if (prop->prop_type == WYNC_PROP_TYPE_STATE) {
-			if (prop->relative_sync_enabled) {
+		if (prop_type[prop_id] == WYNC_PROP_TYPE_STATE) {
+			if (flags & WYNC_PROP_FLAG_RELATIVE_SYNC) {
 				u32_DynArr_insert(
 					&ctx->co_filter_c.type_state__delta_prop_ids, prop_id);
-				if (prop->xtrap_enabled) {
+				if (flags & WYNC_PROP_FLAG_XTRAP) {
 					u32_DynArr_insert(
 						&ctx->co_filter_c.type_state__predicted_delta_prop_ids, prop_id);
 				}
 			}
 			// regular props
 			else { 
-				if (prop->xtrap_enabled) {
+				if (flags & WYNC_PROP_FLAG_XTRAP) {
 					u32_DynArr_insert(
 						&ctx->co_filter_c.type_state__predicted_regular_prop_ids, prop_id);
 				}
-				if (prop->lerp_enabled) {
+				if (flags & WYNC_PROP_FLAG_LERP) {
 					u32_DynArr_insert(
 						&ctx->co_filter_c.type_state__interpolated_regular_prop_ids, prop_id);
 				}
@@ -258,15 +676,13 @@ void WyncWrapper_client_filter_prop_ids (WyncCtx *ctx) {
 		if (!WyncXtrap_is_entity_predicted(ctx, wync_entity_id)) continue;
 		u32_DynArr_insert(&ctx->co_pred.predicted_entity_ids, wync_entity_id);
 	}
+
+	WyncWrapper_client_cache_predicted_entity_props(ctx);
 }
 
 void WyncWrapper_extract_rela_prop_fullsnapshot_to_tick (
 	WyncCtx *ctx, int save_on_tick
 ) {
-	WyncProp *prop = NULL;
-	WyncWrapper_Getter *getter = NULL;
-	WyncWrapper_UserCtx *user_ctx = NULL;
-
 	u32_DynArr_sort(&ctx->co_throttling.rela_prop_ids_for_full_snapshot);
 	uint last_prop_id = 0;
 
@@ -282,15 +698,7 @@ void WyncWrapper_extract_rela_prop_fullsnapshot_to_tick (
 		}
 		last_prop_id = prop_id;
 
-		prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
-		getter = &ctx->wrapper->prop_getter[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-
-		if (*getter == NULL) continue;
-		WyncWrapper_Data data = (*getter)(*user_ctx);
-
-		WyncStore_prop_state_buffer_insert(
-			ctx, prop, save_on_tick, (WyncState){data.data_size, data.data});
+		WyncWrapper_extract_prop_to_tick(ctx, prop_id, save_on_tick);
 	}
 }
 
@@ -299,23 +707,10 @@ void WyncWrapper_extract_rela_prop_fullsnapshot_to_tick (
 void WyncWrapper_extract_prop_snapshot_to_tick (
 	WyncCtx *ctx, int save_on_tick, uint32_t prop_amount, uint32_t* prop_ids
 ) {
-	WyncProp *prop = NULL;
-	WyncWrapper_Getter *getter = NULL;
-	WyncWrapper_UserCtx *user_ctx = NULL;
-
 	// save state history per tick
 
 	for (uint i = 0; i < prop_amount; ++i) {
 		uint prop_id = prop_ids[i];
-
-		prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
-		getter = &ctx->wrapper->prop_getter[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-
-		if (*getter == NULL) continue;
-		WyncWrapper_Data data = (*getter)(*user_ctx);
-
-		WyncStore_prop_state_buffer_insert(
-			ctx, prop, save_on_tick, (WyncState){data.data_size, data.data});
+		WyncWrapper_extract_prop_to_tick(ctx, prop_id, save_on_tick);
 	}
 }
@@ -11,16 +11,27 @@
 
 WyncXtrap_ticks WyncXtrap_preparation(WyncCtx *ctx) {
 	CoPredictionData *p = &ctx->co_pred;
+	ctx->co_metrics.xtrap_entity_ticks_simulated = 0;
+	ctx->co_metrics.xtrap_entity_ticks_resimulated = 0;
+	ctx->co_metrics.xtrap_entities_over_budget = 0;
+	p->cycle_first_new_tick = p->last_tick_predicted +1;
+	p->resim_budget_used = 0;
 	if (p->last_tick_received == 0) {
 		return (WyncXtrap_ticks) { 0 };
 	}
 
+	// Only rollback when a received state differs from our prediction,
+	// matching entities continue from their last predicted tick
+
+	bool received_new_state =
+		p->last_tick_received_at_tick_prev != p->last_tick_received_at_tick;
+	p->last_tick_received_at_tick_prev = p->last_tick_received_at_tick;
+
 	if (
-		p->last_tick_received_at_tick_prev != p->last_tick_received_at_tick
+		(received_new_state && p->diverged_entity_ids.size > 0)
 		|| p->last_tick_received > p->first_tick_predicted
 	){
 		p->pred_intented_first_tick = p->last_tick_received +1;
-		p->last_tick_received_at_tick_prev = p->last_tick_received_at_tick;
 	} else {
 		p->pred_intented_first_tick = p->last_tick_predicted;
 	}
@@ -36,10 +47,18 @@ WyncXtrap_ticks WyncXtrap_preparation(WyncCtx *ctx) {
 	
 	p->currently_on_predicted_tick = true;
 
+	// with a budget, don't iterate more re-simulation ticks than it allows
+
+	i32 tick_start =
+		p->pred_intented_first_tick - p->max_prediction_tick_threeshold;
+	if (p->resim_budget_entity_ticks > 0) {
+		tick_start = MAX(tick_start,
+			p->cycle_first_new_tick - (i32)p->resim_budget_entity_ticks);
+	}
+
 	return (WyncXtrap_ticks) {
 		true,
-		(u32)(ctx->co_pred.pred_intented_first_tick
-			- ctx->co_pred.max_prediction_tick_threeshold),
+		(u32)tick_start,
 		(u32)(ctx->co_pred.target_tick +1)
 	};
 }
@@ -77,6 +96,28 @@ void WyncXtrap_regular_entities_to_predict(WyncCtx *ctx, i32 tick) {
 		// already predicted
 		if (err != OK || tick <= entity_last_predicted_tick) continue;
 
+		// rollback starts here, the whole re-simulation must fit the budget,
+		// otherwise continue from the confirmed state as if it was current.
+		// Cycles start at most 'budget' ticks back (see preparation), an
+		// entity confirmed before that can't be fully re-simulated either
+
+		CoPredictionData *p = &ctx->co_pred;
+		if (p->resim_budget_entity_ticks > 0
+			&& tick < p->cycle_first_new_tick
+			&& entity_last_predicted_tick <= entity_last_tick
+		) {
+			i32 rollback_tick = entity_last_tick +1;
+			u32 cost = (u32)(p->cycle_first_new_tick - rollback_tick);
+			if (tick > rollback_tick
+				|| p->resim_budget_used + cost > p->resim_budget_entity_ticks) {
+				ConMap_set_pair(&p->entity_last_predicted_tick,
+					entity_id, p->cycle_first_new_tick -1);
+				++ctx->co_metrics.xtrap_entities_over_budget;
+				continue;
+			}
+			p->resim_budget_used += cost;
+		}
+
 		// else, aprove prediction and assume this tick as predicted
 		if (tick > entity_last_predicted_tick) {
 
@@ -86,6 +127,11 @@ void WyncXtrap_regular_entities_to_predict(WyncCtx *ctx, i32 tick) {
 
 		u32_DynArr_insert(
 				&ctx->co_pred.global_entity_ids_to_predict, entity_id);
+
+		++ctx->co_metrics.xtrap_entity_ticks_simulated;
+		if (tick < ctx->co_pred.cycle_first_new_tick) {
+			++ctx->co_metrics.xtrap_entity_ticks_resimulated;
+		}
 	}
 }
 
@@ -109,14 +155,15 @@ bool WyncXtrap_is_entity_predicted (WyncCtx *ctx, u32 entity_id) {
 		return false;
 	}
 
-	WyncProp *prop = NULL;
 	u32_DynArrIterator it = { 0 };
 	while (u32_DynArr_iterator_get_next(entity_props, &it) == OK) {
 		u32 prop_id = *it.item;
+		if (prop_id >= MAX_PROPS) { continue; }
 
-		prop = WyncTrack_get_prop(ctx, prop_id);
-		if (prop == NULL) { continue; }
-		if (prop->xtrap_enabled) return true;
+		u16 flags = ctx->co_track.prop_flags[prop_id];
+		if ((flags & WYNC_PROP_FLAG_ENABLED) && (flags & WYNC_PROP_FLAG_XTRAP)) {
+			return true;
+		}
 	}
 
 	return false;
@@ -132,13 +179,10 @@ static void WyncXtrap_props_update_predicted_states_ticks (
 	for (u32 i = 0; i < prop_id_amount; ++i) {
 		u32 prop_id = prop_ids[i];
 
-		WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
-		if (prop == NULL) {
-			continue;
-		}
-		if (!prop->xtrap_enabled) { // Redundant check?
+		if (!(ctx->co_track.prop_flags[prop_id] & WYNC_PROP_FLAG_XTRAP)) {
 			continue;
 		}
+		WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
 
 		// update store predicted state metadata
 		prop->co_xtrap.pred_prev.server_tick = target_tick -1;
@@ -148,81 +192,190 @@ static void WyncXtrap_props_update_predicted_states_ticks (
 }
 
 
-/// TODO: maybe we could compute this every time we get an update?
-/// Only predicted props
-/// Exclude props I own (Or just exclude TYPE_INPUT?) What about events or
-///   delta props?
-///
-/// @returns out_latest_received_tick
-/// @retval -1 Either entity not found, or tick not found
-static i32 WyncXtrap_entity_get_last_received_tick_from_pred_props (
+/// Call after a prop's 'last_ticks_received' got a tick. The entity's last
+/// received tick is the min over the latest tick of each of it's received
+/// props (see 'predicted_received_prop_ids'), kept incrementally: only when
+/// the last prop sitting at the min moves on the entity's props are scanned.
+/// @param prev_tick The prop's latest received tick before inserting
+void WyncXtrap_update_entity_last_tick_received(
 	WyncCtx *ctx,
-	u32 entity_id
-) {
-	if (!WyncTrack_is_entity_tracked(ctx, entity_id)) {
-		return -1;
-	}
-
-	u32_DynArr *entity_props = NULL;
-	u32_DynArrIterator it = { 0 };
-
-	i32 err = u32_DynArr_ConMap_get(
-		&ctx->co_track.entity_has_props, entity_id, &entity_props);
-	if (err != OK) { return -1; }
-
+	u32 prop_id,
+	i32 prev_tick
+){
+	CoPredictionData *co_pred = &ctx->co_pred;
+	u32 entity_id;
+	i32 entity_index = -1;
 	i32 last_tick = -1;
-	WyncProp *prop = NULL;
 
-	while (u32_DynArr_iterator_get_next(entity_props, &it) == OK) {
-		u32 prop_id = *it.item;
+	if (WyncTrack_prop_get_entity(ctx, prop_id, &entity_id) != OK
+		|| ConMap_get(&co_pred->predicted_entity_index,
+			entity_id, &entity_index) != OK
+		|| ConMap_get(&co_pred->entity_last_received_tick,
+			entity_id, &last_tick) != OK
+	) {
+		return;
+	}
 
-		prop = WyncTrack_get_prop(ctx, prop_id);
-		if (prop == NULL) { continue; }
+	// duplicated or older state doesn't move the prop's latest tick
 
-		// for rela props, ignore base, instead count auxiliar last tick
-		if (prop->relative_sync_enabled) { continue; }
+	WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
+	i32 tick = *i32_RinBuf_get_relative(&prop->statebff.last_ticks_received, 0);
+	if (tick <= prev_tick) { return; }
 
-		i32 prop_last_tick = *i32_RinBuf_get_relative(
-				&prop->statebff.last_ticks_received, 0);
-		if (prop_last_tick == -1) { continue; }
+	u32 *offsets = co_pred->predicted_received_prop_offsets.items;
+	u32 *prop_ids = co_pred->predicted_received_prop_ids.items;
+	u32 first = offsets[entity_index];
+	u32 end = offsets[entity_index +1];
 
-		if (ConMap_has_key(
-			&ctx->co_clientauth.client_owns_prop[ctx->common.my_peer_id],
-			prop_id))
-		{
-			continue;
-		}
+	bool counts = false;
+	for (u32 i = first; i < end; ++i) {
+		if (prop_ids[i] == prop_id) { counts = true; break; }
+	}
+	if (!counts) { return; }
+
+	WyncXtrap_EntityMinTick *min = &co_pred->entity_min_ticks[entity_index];
 
-		if (last_tick == -1) {
-			last_tick = prop_last_tick;
+	if (prev_tick == -1) {
+		// prop's first state
+		if (min->tick == -1 || tick < min->tick) {
+			*min = (WyncXtrap_EntityMinTick) { tick, 1 };
+		} else if (tick == min->tick) {
+			++min->props_at_tick;
+			return;
 		} else {
-			last_tick = MIN(last_tick, prop_last_tick);
+			return;
 		}
 	}
+	else if (prev_tick == min->tick) {
+		if (--min->props_at_tick > 0) { return; }
+
+		// the last prop at the min moved on, find the new min
+
+		*min = (WyncXtrap_EntityMinTick) { -1, 0 };
+		for (u32 i = first; i < end; ++i) {
+			WyncProp *entity_prop = WyncTrack_get_prop_unsafe(ctx, prop_ids[i]);
+			i32 prop_tick = *i32_RinBuf_get_relative(
+				&entity_prop->statebff.last_ticks_received, 0);
+			if (prop_tick == -1) { continue; }
+
+			if (min->tick == -1 || prop_tick < min->tick) {
+				*min = (WyncXtrap_EntityMinTick) { prop_tick, 1 };
+			} else if (prop_tick == min->tick) {
+				++min->props_at_tick;
+			}
+		}
+	}
+	else {
+		return;
+	}
 
-	return last_tick;
+	ConMap_set_pair(&co_pred->entity_last_received_tick, entity_id, min->tick);
 }
 
 
-/// NOTE: assuming snap props always include all snaps for an entity
-void WyncXtrap_update_entity_last_tick_received(
+void WyncXtrap_set_resimulation_budget (WyncCtx *ctx, u32 max_entity_ticks) {
+	ctx->co_pred.resim_budget_entity_ticks = max_entity_ticks;
+}
+
+
+/// @returns The state predicted for 'tick', empty if it isn't in the history
+WyncState WyncXtrap_prop_get_predicted_state (WyncProp *prop, i32 tick) {
+	if (prop->co_xtrap.pred_history == NULL || tick < 0) {
+		return (WyncState) { 0 };
+	}
+	WyncProp_PredState *slot =
+		&prop->co_xtrap.pred_history[tick & (PRED_STATE_HISTORY_SIZE -1)];
+	if (slot->tick != tick) {
+		return (WyncState) { 0 };
+	}
+	return slot->state;
+}
+
+
+/// Also records misprediction statistics
+/// @returns Whether the state received for 'tick' is the one we predicted
+bool WyncXtrap_prop_prediction_matches (
 	WyncCtx *ctx,
-	u32 prop_id
-){
-	u32 entity_id;
-	i32 err = WyncTrack_prop_get_entity(ctx, prop_id, &entity_id);
-	if (err != OK) {
-		LOG_WAR_C(ctx, "Couldn't find entity_id for prop_id(%d)", prop_id);
-		return;
+	WyncProp *prop,
+	u32 prop_id,
+	i32 tick
+) {
+	if (prop->relative_sync_enabled) {
+		return false;
+	}
+	WyncState predicted = WyncXtrap_prop_get_predicted_state(prop, tick);
+	WyncState received = WyncState_prop_state_buffer_get(prop, tick);
+	if (predicted.data == NULL || received.data == NULL) {
+		return false;
 	}
 
-	i32 last_tick =
-		WyncXtrap_entity_get_last_received_tick_from_pred_props(
-			ctx, entity_id);
-	if (last_tick < 0) { return; }
+	WyncProp_Xtrap *xtrap = &prop->co_xtrap;
+	++xtrap->pred_checked;
+	++ctx->co_metrics.xtrap_predictions_checked;
+
+	bool exact = predicted.data_size == received.data_size
+		&& memcmp(predicted.data, received.data, received.data_size) == 0;
+
+	// the error is measured on every check, rollback or not
 
-	ConMap_set_pair(&ctx->co_pred.entity_last_received_tick,
-		entity_id, last_tick);
+	WyncWrapper_DistanceFunc distance = ctx->wrapper->prop_pred_distance[prop_id];
+	if (distance != NULL) {
+		float error = exact ? 0 : distance(
+			(WyncWrapper_Data) { predicted.data_size, predicted.data },
+			(WyncWrapper_Data) { received.data_size, received.data });
+		++xtrap->pred_error_samples;
+		xtrap->pred_error_sum += error;
+		xtrap->pred_error_max = MAX(xtrap->pred_error_max, error);
+
+		if (error <= xtrap->pred_tolerance) {
+			return true;
+		}
+	}
+	else if (exact) {
+		return true;
+	}
+
+	++xtrap->pred_mispredicted;
+	++ctx->co_metrics.xtrap_mispredictions;
+	return false;
+}
+
+
+/// Keeps a copy of the state of props predicted this tick
+static void WyncXtrap_save_predicted_history (WyncCtx *ctx, i32 tick) {
+	u32 *offsets = ctx->co_pred.predicted_xtrap_prop_offsets.items;
+	u32 *prop_ids = ctx->co_pred.predicted_xtrap_prop_ids.items;
+	u32_DynArrIterator it = { 0 };
+
+	while (u32_DynArr_iterator_get_next(
+		&ctx->co_pred.global_entity_ids_to_predict, &it) == OK)
+	{
+		i32 entity_index = -1;
+		i32 err = ConMap_get(
+			&ctx->co_pred.predicted_entity_index, *it.item, &entity_index);
+		if (err != OK) { continue; }
+
+		for (u32 k = offsets[entity_index]; k < offsets[entity_index +1]; ++k) {
+			u32 prop_id = prop_ids[k];
+			WyncProp *prop = WyncTrack_get_prop_unsafe(ctx, prop_id);
+			if (prop->co_xtrap.pred_history == NULL) {
+				continue;
+			}
+			WyncProp_PredState *slot = &prop->co_xtrap.pred_history
+				[tick & (PRED_STATE_HISTORY_SIZE -1)];
+
+			WyncState extracted = { 0 };
+			bool must_free = false;
+			err = WyncWrapper_get_prop_state_shared(
+				ctx, prop_id, &extracted, &must_free);
+			if (err == OK && extracted.data != NULL) {
+				WyncState_set_from_buffer(
+					&slot->state, extracted.data_size, extracted.data);
+				slot->tick = tick;
+			}
+			if (must_free) { WyncState_free(&extracted); }
+		}
+	}
 }
 
 
@@ -267,8 +420,6 @@ static void WyncXtrap_props_update_predicted_states_data (
 	u32 *prop_ids,
 	u32 prop_id_amount
 ) {
-	WyncWrapper_Getter *getter = NULL;
-	WyncWrapper_UserCtx *user_ctx = NULL;
 	Wync_NetTickData *pred_curr = NULL;
 	Wync_NetTickData *pred_prev = NULL;
 	WyncProp *prop = NULL;
@@ -287,12 +438,12 @@ static void WyncXtrap_props_update_predicted_states_data (
 		pred_curr = &prop->co_xtrap.pred_curr;
 		pred_prev = &prop->co_xtrap.pred_prev;
 		
-		getter = &ctx->wrapper->prop_getter[prop_id];
-		user_ctx = &ctx->wrapper->prop_user_ctx[prop_id];
-		if (*getter == NULL) { continue; }
-
-		WyncWrapper_Data extracted = (*getter)(*user_ctx);
-		if (extracted.data_size == 0 || extracted.data == NULL) {
+		WyncState extracted = { 0 };
+		bool must_free = false;
+		i32 err = WyncWrapper_get_prop_state_shared(
+			ctx, prop_id, &extracted, &must_free);
+		if (err != OK) {
+			if (must_free) { WyncState_free(&extracted); }
 			continue;
 		}
 
@@ -301,7 +452,7 @@ static void WyncXtrap_props_update_predicted_states_data (
 		WyncState_set_from_buffer(
 			&pred_curr->data, extracted.data_size, extracted.data);
 
-		WyncWrapper_Data_free(extracted);
+		if (must_free) { WyncState_free(&extracted); }
 	}
 }
 
@@ -312,32 +463,19 @@ static void WyncXtrap_save_latest_predicted_state (WyncCtx *ctx, i32 tick) {
 	i32 store_predicted_states = tick > (ctx->co_pred.target_tick - 1);
 	if (!store_predicted_states) return;
 
-	u32_DynArr *entity_props = NULL;
-	u32_DynArrIterator it = { 0 };
+	// predicted props of every predicted entity, cached on filter
 
-	while (u32_DynArr_iterator_get_next(
-			&ctx->co_pred.predicted_entity_ids, &it) == OK)
-	{
-		u32 wync_entity_id = *it.item;
+	u32 *prop_ids = ctx->co_pred.predicted_xtrap_prop_ids.items;
+	u32 prop_amount = (u32)ctx->co_pred.predicted_xtrap_prop_ids.size;
 
-		entity_props = NULL;
-		i32 err = u32_DynArr_ConMap_get (&ctx->co_track.entity_has_props,
-				wync_entity_id, &entity_props);
-		if (err != OK) {
-			LOG_ERR_C(ctx, "Couldn't find entity (%d)'s props", wync_entity_id);
-			continue;
-		}
-
-		// TODO: Make this call user-level
-		// 1. store predicted states
-		// 2. store predicted states
+	// TODO: Make this call user-level
+	// 1. store predicted states
+	// 2. store predicted states
 
-		WyncXtrap_props_update_predicted_states_data( ctx,
-			entity_props->items, (u32)entity_props->size);
+	WyncXtrap_props_update_predicted_states_data(ctx, prop_ids, prop_amount);
 
-		WyncXtrap_props_update_predicted_states_ticks( ctx,
-			ctx->co_pred.target_tick, entity_props->items, (u32)entity_props->size);
-	}
+	WyncXtrap_props_update_predicted_states_ticks(
+		ctx, ctx->co_pred.target_tick, prop_ids, prop_amount);
 }
 
 
@@ -362,12 +500,33 @@ static void WyncXtrap_internal_tick_end(WyncCtx *ctx, i32 tick) {
 
 
 void WyncXtrap_tick_end(WyncCtx *ctx, i32 tick) {
+	WyncXtrap_save_predicted_history (ctx, tick);
 	WyncXtrap_save_latest_predicted_state (ctx, tick);
 	WyncXtrap_internal_tick_end(ctx, tick);
 }
 
 
 
+/// @returns error
+i32 WyncXtrap_get_predicted_state (
+	WyncCtx *ctx,
+	u32 prop_id,
+	i32 tick,
+	WyncWrapper_Data *out_state
+) {
+	WyncProp *prop = WyncTrack_get_prop(ctx, prop_id);
+	if (prop == NULL) {
+		return -1;
+	}
+	WyncState state = WyncXtrap_prop_get_predicted_state(prop, tick);
+	if (state.data == NULL) {
+		return -2;
+	}
+	*out_state = (WyncWrapper_Data) { state.data_size, state.data };
+	return OK;
+}
+
+
 bool WyncXtrap_allowed_to_predict_entity(WyncCtx *ctx, uint entity_id) {
 	if (ctx->common.is_client) {
 		return u32_DynArr_has(
@@ -65,6 +65,17 @@ WyncWrapper_Data ball_instance_get_position (WyncWrapper_UserCtx ctx) {
 	return data;
 }
 
+uint32_t ball_instance_get_position_into (
+	WyncWrapper_UserCtx ctx, void *dst, uint32_t capacity
+) {
+	if (ctx.type_size != sizeof(Ball) || capacity < sizeof(Vector2i)) {
+		return 0;
+	}
+	Ball *ball_instance = (Ball *)ctx.ctx;
+	memcpy(dst, &ball_instance->position, sizeof(Vector2i));
+	return sizeof(Vector2i);
+}
+
 void ball_instance_set_input(WyncWrapper_UserCtx ctx, WyncWrapper_Data data) {
 	if (ctx.type_size != sizeof(Ball) || data.data_size != sizeof(int))
 	{ return; }
@@ -4,6 +4,7 @@
 #include "../wync.h"
 #include "../src/wync_private.h"
 #include <stdio.h>
+#include <math.h>
 #define WYNC_TESTING
 
 #ifdef WIN32
@@ -296,6 +297,39 @@ void util_timewarp(void) {
 }
 
 
+/// Received ticks stay sorted, duplicated and too old ticks are dropped
+void test_ring_insert_sorted (void) {
+	TESTS_INIT();
+
+	i32_RinBuf ring = i32_RinBuf_create(4, -1);
+	TEST_INT(i32_RinBuf_insert_sorted(&ring, 10), OK);
+	TEST_INT(i32_RinBuf_insert_sorted(&ring, 12), OK);
+	TEST_INT(i32_RinBuf_insert_sorted(&ring, 11), OK);
+	TEST_INT(*i32_RinBuf_get_relative(&ring, 0), 12);
+
+	TEST_FALSE(i32_RinBuf_insert_sorted(&ring, 12) == OK);
+	TEST_FALSE(i32_RinBuf_insert_sorted(&ring, 11) == OK);
+	TEST_INT(*i32_RinBuf_get_absolute(&ring, 0), -1);
+
+	// full, the smallest is evicted and older ticks don't get in
+
+	TEST_INT(i32_RinBuf_insert_sorted(&ring, 14), OK);
+	TEST_INT(i32_RinBuf_insert_sorted(&ring, 13), OK);
+	TEST_FALSE(i32_RinBuf_insert_sorted(&ring, 9) == OK);
+	TEST_FALSE(i32_RinBuf_insert_sorted(&ring, 10) == OK);
+
+	i32 expected[] = { 11, 12, 13, 14 };
+	for (size_t i = 0; i < 4; ++i) {
+		TEST_INT(*i32_RinBuf_get_absolute(&ring, i), expected[i]);
+	}
+	TEST_INT(*i32_RinBuf_get_relative(&ring, 0), 14);
+	TEST_INT(*i32_RinBuf_get_relative(&ring, (size_t)-1), 13);
+
+	free(ring.buffer);
+	TESTS_SHOW_RESULTS();
+}
+
+
 /// A Client connects to a Server
 void test_join (void) {
 	TESTS_INIT();
@@ -521,6 +555,304 @@ void test_snapshot (void) {
 }
 
 
+static uint32_t ball_batch_set_calls = 0;
+
+static void ball_batch_set_position (
+	WyncWrapper_UserCtx *ctxs, WyncWrapper_Data *datas, uint32_t amount
+) {
+	++ball_batch_set_calls;
+	for (uint32_t i = 0; i < amount; ++i) {
+		ball_instance_set_position(ctxs[i], datas[i]);
+	}
+}
+
+
+static uint32_t growing_state_size = 0;
+
+static uint32_t growing_state_get_into (
+	WyncWrapper_UserCtx ctx, void *dst, uint32_t capacity
+) {
+	if (growing_state_size > capacity) { return 0; }
+	memset(dst, (int)growing_state_size, growing_state_size);
+	return growing_state_size;
+}
+
+
+/// Server extracts a fixed size prop straight into it's history
+void test_sized_prop (void) {
+	TESTS_INIT();
+	util_reset_state();
+
+	uint actor_id = 2;
+	server_gs.balls[actor_id].enabled = true;
+	server_gs.balls[actor_id].position = (Vector2i) { 10, 20 };
+
+	util_setup_server_and_client();
+	TEST_INT(WyncTrack_track_entity(server_gs.wctx, actor_id, 0), OK);
+
+	uint pos_prop_id = 999;
+	int error = WyncTrack_prop_register_sized(
+		server_gs.wctx,
+		actor_id,
+		"position",
+		WYNC_PROP_TYPE_STATE,
+		sizeof(Vector2i),
+		&pos_prop_id
+	);
+	TEST_INT(error, OK);
+
+	Ball *ball_instance = &server_gs.balls[actor_id];
+	WyncWrapper_set_prop_callbacks_into(
+		server_gs.wctx,
+		pos_prop_id,
+		(WyncWrapper_UserCtx) { .ctx = ball_instance, .type_size = sizeof(Ball) },
+		ball_instance_get_position_into,
+		ball_instance_set_position
+	);
+
+	// extract two ticks
+
+	WyncWrapper_server_filter_prop_ids(server_gs.wctx);
+	WyncWrapper_extract_data_to_tick(server_gs.wctx, 100);
+	ball_instance->position = (Vector2i) { 11, 21 };
+	WyncWrapper_extract_data_to_tick(server_gs.wctx, 101);
+
+	WyncProp *prop = WyncTrack_get_prop(server_gs.wctx, pos_prop_id);
+	TEST_TRUE(prop->statebff.slab != NULL);
+
+	WyncState state = WyncState_prop_state_buffer_get(prop, 100);
+	TEST_UINT(state.data_size, sizeof(Vector2i));
+	TEST_INT(((Vector2i*)state.data)->x, 10);
+	TEST_INT(((Vector2i*)state.data)->y, 20);
+	TEST_TRUE((char*)state.data >= prop->statebff.slab);
+
+	state = WyncState_prop_state_buffer_get(prop, 101);
+	TEST_INT(((Vector2i*)state.data)->x, 11);
+	TEST_INT(((Vector2i*)state.data)->y, 21);
+
+	// a setter-only batch keeps extracting through the prop's own getter
+
+	TEST_INT(WyncWrapper_register_batch_callbacks(server_gs.wctx, 0,
+		"position", NULL, ball_batch_set_position), OK);
+	WyncWrapper_server_filter_prop_ids(server_gs.wctx);
+	ball_instance->position = (Vector2i) { 12, 22 };
+	WyncWrapper_extract_data_to_tick(server_gs.wctx, 102);
+
+	state = WyncState_prop_state_buffer_get(prop, 102);
+	TEST_UINT(state.data_size, sizeof(Vector2i));
+	TEST_INT(((Vector2i*)state.data)->x, 12);
+
+	WyncState_reset_all_state_to_confirmed_tick_absolute(
+		server_gs.wctx, &pos_prop_id, 1, 101);
+	TEST_INT(ball_instance->position.x, 11);
+
+	// timewarp lerps of batched props are set in a single batch call
+
+	util_setup_lerp_types(server_gs.wctx);
+	uint lerp_entity_ids[2] = { 1, 3 };
+	uint lerp_prop_ids[2] = { 999, 999 };
+	for (uint i = 0; i < 2; ++i) {
+		uint entity_id = lerp_entity_ids[i];
+		Ball *ball = &server_gs.balls[entity_id];
+		ball->enabled = true;
+		TEST_INT(WyncTrack_track_entity(server_gs.wctx, entity_id, 0), OK);
+		TEST_INT(WyncTrack_prop_register_sized(server_gs.wctx, entity_id,
+			"position", WYNC_PROP_TYPE_STATE, sizeof(Vector2i),
+			&lerp_prop_ids[i]), OK);
+		WyncWrapper_set_prop_callbacks_into(
+			server_gs.wctx,
+			lerp_prop_ids[i],
+			(WyncWrapper_UserCtx) { .ctx = ball, .type_size = sizeof(Ball) },
+			ball_instance_get_position_into,
+			NULL
+		);
+		TEST_INT(WyncProp_enable_interpolation(server_gs.wctx, lerp_prop_ids[i],
+			LERP_DATA_TYPE_VECTOR2I, ball_instance_set_position), OK);
+
+		ball->position = (Vector2i) { 0, 0 };
+		TEST_INT(WyncWrapper_extract_prop_to_tick(
+			server_gs.wctx, lerp_prop_ids[i], 200), OK);
+		ball->position = (Vector2i) { 10 * ((int)i +1), 0 };
+		TEST_INT(WyncWrapper_extract_prop_to_tick(
+			server_gs.wctx, lerp_prop_ids[i], 201), OK);
+	}
+
+	ball_batch_set_calls = 0;
+	float frame_ms = 1000.f / server_gs.wctx->common.physic_ticks_per_second;
+	WyncLerp_reset_to_interpolated_absolute(
+		server_gs.wctx, lerp_prop_ids, 2, 200, frame_ms / 2);
+	TEST_UINT(ball_batch_set_calls, 1);
+	TEST_INT(server_gs.balls[lerp_entity_ids[0]].position.x, 5);
+	TEST_INT(server_gs.balls[lerp_entity_ids[1]].position.x, 10);
+
+	// plain state props keep a shallow history
+
+	TEST_UINT(prop->statebff.saved_states.size, 2);
+	TEST_UINT(prop->statebff.last_ticks_received.size, 2);
+	TEST_INT(WyncProp_set_history_depth(server_gs.wctx, pos_prop_id, 16), OK);
+	TEST_UINT(prop->statebff.saved_states.size, 16);
+	TEST_UINT(prop->statebff.last_ticks_received.size, 16);
+
+	// without a declared size the state can outgrow it's first size
+
+	uint grown_prop_id = 999;
+	TEST_INT(WyncTrack_prop_register_minimal(server_gs.wctx, actor_id,
+		"grown", WYNC_PROP_TYPE_STATE, &grown_prop_id), OK);
+	WyncWrapper_set_prop_callbacks_into(
+		server_gs.wctx,
+		grown_prop_id,
+		(WyncWrapper_UserCtx) { .ctx = ball_instance, .type_size = sizeof(Ball) },
+		growing_state_get_into,
+		NULL
+	);
+	TEST_INT(WyncProp_set_history_depth(server_gs.wctx, grown_prop_id, 4), OK);
+	WyncProp *grown_prop = WyncTrack_get_prop(server_gs.wctx, grown_prop_id);
+
+	uint32_t sizes[] = { 8, 32, 8 };
+	for (int i = 0; i < 3; ++i) {
+		growing_state_size = sizes[i];
+		TEST_INT(WyncWrapper_extract_prop_to_tick(
+			server_gs.wctx, grown_prop_id, 100 + i), OK);
+	}
+	for (int i = 0; i < 3; ++i) {
+		state = WyncState_prop_state_buffer_get(grown_prop, 100 + i);
+		TEST_UINT(state.data_size, sizes[i]);
+		TEST_TRUE(state.data != NULL
+			&& ((unsigned char*)state.data)[sizes[i] -1] == sizes[i]);
+	}
+
+	// equally sized snaps don't repeat their size on the wire
+
+	Vector2i positions[2] = { { 1, 2 }, { 3, 4 } };
+	WyncSnap snaps[2] = {
+		{ .prop_id = 7, .data = { sizeof(Vector2i), &positions[0] } },
+		{ .prop_id = 8, .data = { sizeof(Vector2i), &positions[1] } },
+	};
+	WyncPktSnap pkt = { .tick = 100, .snap_amount = 2, .snaps = snaps };
+
+	char data[128] = { 0 };
+	NeteBuffer buffer = { .size_bytes = sizeof(data), .data = data };
+	TEST_TRUE(WyncPktSnap_serialize(false, &buffer, &pkt));
+	TEST_UINT(buffer.cursor_byte,
+		sizeof(u32) + sizeof(u16) + 3 * sizeof(u32) + 2 * sizeof(Vector2i));
+
+	WyncPktSnap pkt_read = { 0 };
+	NeteBuffer_reset_cursor(&buffer);
+	TEST_TRUE(WyncPktSnap_serialize(true, &buffer, &pkt_read));
+	TEST_UINT(pkt_read.snaps[1].prop_id, 8);
+	TEST_UINT(pkt_read.snaps[1].data.data_size, sizeof(Vector2i));
+	TEST_INT(((Vector2i*)pkt_read.snaps[1].data.data)->y, 4);
+	WyncPktSnap_free(&pkt_read);
+
+	// snap amounts colliding with the input acks flag are rejected
+
+	pkt.snap_amount = WYNC_SNAP_HAS_INPUT_ACKS_BIT;
+	NeteBuffer_reset_cursor(&buffer);
+	TEST_FALSE(WyncPktSnap_serialize(false, &buffer, &pkt));
+
+	TESTS_SHOW_RESULTS();
+}
+
+
+/// Consecutive inputs are sent as repeats and XOR deltas
+void test_input_delta_encoding (void) {
+	TESTS_INIT();
+
+	// 8 equal inputs, one changed byte and a tick gap
+
+	u32 amount = 10;
+	u8 values[10][8] = { 0 };
+	WyncTickDecorator inputs[10];
+	for (u32 i = 0; i < amount; ++i) {
+		values[i][0] = 7;
+		inputs[i] = (WyncTickDecorator) {
+			.tick = 300 + i, .state = { sizeof(values[i]), values[i] } };
+	}
+	values[8][3] = 1;
+	values[9][3] = 1;
+	values[9][4] = 2;
+	inputs[9].tick = 320;
+
+	WyncPktInputs pkt = { .prop_id = 5, .amount = amount, .inputs = inputs };
+
+	char data[256] = { 0 };
+	NeteBuffer buffer = { .size_bytes = sizeof(data), .data = data };
+	TEST_TRUE(WyncPktInputs_serialize(false, &buffer, &pkt));
+	TEST_TRUE(buffer.cursor_byte < amount * (2 * sizeof(u32) + 8) / 3);
+
+	WyncPktInputs pkt_read = { 0 };
+	NeteBuffer_reset_cursor(&buffer);
+	TEST_TRUE(WyncPktInputs_serialize(true, &buffer, &pkt_read));
+	TEST_UINT(pkt_read.prop_id, 5);
+	TEST_UINT(pkt_read.amount, amount);
+
+	bool all_equal = true;
+	for (u32 i = 0; i < amount; ++i) {
+		all_equal = all_equal
+			&& pkt_read.inputs[i].tick == inputs[i].tick
+			&& pkt_read.inputs[i].state.data_size == sizeof(values[i])
+			&& memcmp(pkt_read.inputs[i].state.data, values[i], 8) == 0;
+	}
+	TEST_TRUE(all_equal);
+	WyncPktInputs_free(&pkt_read);
+
+	// input amounts above the input buffer are rejected
+
+	u32 header = INPUT_BUFFER_SIZE + 1;
+	memcpy(data + sizeof(u32), &header, sizeof(header));
+	NeteBuffer_reset_cursor(&buffer);
+	TEST_FALSE(WyncPktInputs_serialize(true, &buffer, &pkt_read));
+	TEST_UINT(pkt_read.amount, 0);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
+/// Built-in lerp kernels
+void test_lerp_kernels (void) {
+	TESTS_INIT();
+
+	float from_f[3] = { 0, 10, -4 };
+	float to_f[3] = { 1, 20, 4 };
+	float out_f[3] = { 0 };
+	TEST_INT(WyncLerp_run_kernel(WYNC_LERP_KERNEL_F32,
+		(WyncWrapper_Data) { sizeof(from_f), from_f },
+		(WyncWrapper_Data) { sizeof(to_f), to_f }, 0.25f, out_f), OK);
+	TEST_TRUE(fabsf(out_f[0] - 0.25f) < 1e-5f);
+	TEST_TRUE(fabsf(out_f[1] - 12.5f) < 1e-5f);
+	TEST_TRUE(fabsf(out_f[2] + 2.f) < 1e-5f);
+
+	i32 from_i[2] = { 100, -100 };
+	i32 to_i[2] = { 200, 100 };
+	i32 out_i[2] = { 0 };
+	TEST_INT(WyncLerp_run_kernel(WYNC_LERP_KERNEL_I32,
+		(WyncWrapper_Data) { sizeof(from_i), from_i },
+		(WyncWrapper_Data) { sizeof(to_i), to_i }, 0.5f, out_i), OK);
+	TEST_INT(out_i[0], 150);
+	TEST_INT(out_i[1], 0);
+
+	// halfway between identity and 90 degrees around Z is 45 degrees
+
+	float s45 = sinf(0.39269908f), c45 = cosf(0.39269908f);
+	float from_q[4] = { 0, 0, 0, 1 };
+	float to_q[4] = { 0, 0, sinf(0.78539816f), cosf(0.78539816f) };
+	float out_q[4] = { 0 };
+	TEST_INT(WyncLerp_run_kernel(WYNC_LERP_KERNEL_QUAT_SLERP,
+		(WyncWrapper_Data) { sizeof(from_q), from_q },
+		(WyncWrapper_Data) { sizeof(to_q), to_q }, 0.5f, out_q), OK);
+	TEST_TRUE(fabsf(out_q[2] - s45) < 1e-5f);
+	TEST_TRUE(fabsf(out_q[3] - c45) < 1e-5f);
+
+	// mismatched sizes are rejected
+
+	TEST_FALSE(WyncLerp_run_kernel(WYNC_LERP_KERNEL_F32,
+		(WyncWrapper_Data) { sizeof(from_f), from_f },
+		(WyncWrapper_Data) { sizeof(float), to_f }, 0.5f, out_f) == OK);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
 void util_setup_tracking_ball (
 	GameState* gs, uint entity_id, uint *pos_prop_id, uint *input_prop_id,
 	bool enable_lerping
@@ -567,6 +899,62 @@ void util_setup_tracking_ball (
 }
 
 
+/// Ticks sharing a home slot in the history index probe past the end of the
+/// table, evicting states keeps the rest reachable
+void test_state_history_index (void) {
+	TESTS_INIT();
+	util_reset_state();
+	util_setup_server_and_client();
+
+	WyncCtx *ctx = server_gs.wctx;
+	uint actor_id = 1;
+	uint pos_prop_id = 999, input_prop_id = 999;
+	TEST_INT(WyncTrack_track_entity(ctx, actor_id, 0), OK);
+	util_setup_tracking_ball(
+		&server_gs, actor_id, &pos_prop_id, &input_prop_id, false);
+	TEST_INT(WyncProp_set_history_depth(ctx, pos_prop_id, 4), OK);
+	WyncProp *prop = WyncTrack_get_prop(ctx, pos_prop_id);
+	TEST_UINT(prop->statebff.tick_to_state_id.size, 8);
+
+	// 7, 15 and 23 share the last slot, 8 is pushed after them
+
+	i32 ticks[] = { 7, 15, 23, 8, 9, 31 };
+	for (int i = 0; i < 6; ++i) {
+		Vector2i value = { ticks[i], i };
+		WyncStore_prop_state_buffer_insert_copy(
+			ctx, prop, ticks[i], sizeof(Vector2i), &value);
+
+		// the history keeps the last 4
+		for (int k = 0; k <= i; ++k) {
+			WyncState state = WyncState_prop_state_buffer_get(prop, ticks[k]);
+			if (k <= i -4) {
+				TEST_TRUE(state.data == NULL);
+				continue;
+			}
+			TEST_TRUE(state.data != NULL);
+			if (state.data == NULL) { continue; }
+			TEST_INT(((Vector2i*)state.data)->x, ticks[k]);
+			TEST_INT(((Vector2i*)state.data)->y, k);
+		}
+	}
+
+	// storing a tick again replaces it in place
+
+	Vector2i value = { 23, 100 };
+	WyncStore_prop_state_buffer_insert_copy(
+		ctx, prop, 23, sizeof(Vector2i), &value);
+	WyncState state = WyncState_prop_state_buffer_get(prop, 23);
+	TEST_TRUE(state.data != NULL);
+	TEST_INT(((Vector2i*)state.data)->y, 100);
+	TEST_TRUE(WyncState_prop_state_buffer_get(prop, 8).data != NULL);
+	TEST_TRUE(WyncState_prop_state_buffer_get(prop, 9).data != NULL);
+	TEST_TRUE(WyncState_prop_state_buffer_get(prop, 31).data != NULL);
+	TEST_TRUE(WyncState_prop_state_buffer_get(prop, 39).data == NULL);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
 void test_client_authority_inputs (void) {
 	TESTS_INIT();
 
@@ -702,6 +1090,51 @@ void test_client_authority_inputs (void) {
 		client_gs.balls[actor_id].input_move_direction
 	);
 
+	// client, inputs the server acked aren't sent again
+
+	WyncCtx *client_ctx = client_gs.wctx;
+	u32 *inputs_received = &server_gs.wctx->co_metrics.debug_packets_received[
+		WYNC_PKT_INPUTS][0];
+	for (uint tick = 201; tick < 204; ++tick) {
+		client_ctx->co_pred.target_tick = tick;
+		WyncWrapper_buffer_inputs(client_ctx);
+	}
+	client_ctx->co_pred.target_tick = 204;
+
+	WyncPktSnap_InputAck ack = { input_prop_id, 201 };
+	WyncPktSnap pkt_ack = {
+		.tick = 201, .input_ack_amount = 1, .input_acks = &ack };
+	WyncStore_handle_pkt_prop_snap(client_ctx, pkt_ack);
+
+	u32 inputs_before = *inputs_received;
+	WyncSend_client_send_inputs(client_ctx);
+	util_send_packets_to(client_gs.network_peer_id, client_ctx, server_gs.wctx);
+	u32 inputs_sent = *inputs_received - inputs_before;
+	TEST_TRUE(inputs_sent > 0);
+
+	WyncProp *server_input_prop = WyncTrack_get_prop(
+		server_gs.wctx, input_prop_id);
+	TEST_TRUE(WyncState_prop_state_buffer_get(
+		server_input_prop, 201).data == NULL);
+	TEST_TRUE(WyncState_prop_state_buffer_get(
+		server_input_prop, 202).data != NULL);
+	TEST_TRUE(WyncState_prop_state_buffer_get(
+		server_input_prop, 203).data != NULL);
+
+	// client, unacked inputs are resent until acked
+
+	inputs_before = *inputs_received;
+	WyncSend_client_send_inputs(client_ctx);
+	util_send_packets_to(client_gs.network_peer_id, client_ctx, server_gs.wctx);
+	TEST_UINT(*inputs_received - inputs_before, inputs_sent);
+
+	ack.tick = 203;
+	WyncStore_handle_pkt_prop_snap(client_ctx, pkt_ack);
+	inputs_before = *inputs_received;
+	WyncSend_client_send_inputs(client_ctx);
+	util_send_packets_to(client_gs.network_peer_id, client_ctx, server_gs.wctx);
+	TEST_UINT(*inputs_received - inputs_before, inputs_sent -1);
+
 	util_simulate_game_engine_logic_cycle ();
 
 	TESTS_SHOW_RESULTS();
@@ -904,6 +1337,24 @@ void test_extrapolation (void) {
 
 	TEST_FALSE(client_gs.wctx->co_pred.currently_on_predicted_tick);
 
+	// client, predicted states are kept by tick
+
+	uint predicted_prop_id = client_gs.wctx->co_filter_c
+		.type_state__predicted_regular_prop_ids.items[0];
+	WyncWrapper_Data predicted_state = { 0 };
+	TEST_INT(WyncXtrap_get_predicted_state(client_gs.wctx,
+		predicted_prop_id, xtrap_ticks.tick_end -1, &predicted_state), OK);
+	TEST_UINT(predicted_state.data_size, sizeof(Vector2i));
+	TEST_INT(((Vector2i*)predicted_state.data)->x, 1010);
+	TEST_FALSE(WyncXtrap_get_predicted_state(client_gs.wctx,
+		predicted_prop_id, xtrap_ticks.tick_end, &predicted_state) == OK);
+
+	WyncStat_Prediction pred_metrics = { 0 };
+	WyncStat_get_prediction_metrics(client_gs.wctx, &pred_metrics);
+	TEST_UINT(pred_metrics.entity_ticks_simulated,
+		xtrap_ticks.tick_end - xtrap_ticks.tick_start);
+	TEST_UINT(pred_metrics.entity_ticks_resimulated, 0);
+
 	// ==========================================================
 	//
 	// LERPING TEST (PREDICTED STATE)
@@ -933,6 +1384,345 @@ void test_extrapolation (void) {
 }
 
 
+static float vector2i_distance (
+	WyncWrapper_Data predicted, WyncWrapper_Data confirmed
+) {
+	Vector2i *a = (Vector2i*)predicted.data;
+	Vector2i *b = (Vector2i*)confirmed.data;
+	return (float)(abs(a->x - b->x) + abs(a->y - b->y));
+}
+
+
+/// Prediction error is measured on every check, not only on rollbacks
+void test_prediction_error (void) {
+	TESTS_INIT();
+	util_reset_state();
+	util_setup_server_and_client();
+
+	WyncCtx *ctx = client_gs.wctx;
+	uint actor_id = 2;
+	uint pos_prop_id = 999, input_prop_id = 999;
+	TEST_INT(WyncTrack_track_entity(ctx, actor_id, 0), OK);
+	util_setup_tracking_ball(
+		&client_gs, actor_id, &pos_prop_id, &input_prop_id, false);
+	TEST_INT(WyncProp_enable_prediction(ctx, pos_prop_id), OK);
+	TEST_INT(WyncProp_set_prediction_tolerance(
+		ctx, pos_prop_id, vector2i_distance, 1), OK);
+	WyncProp *prop = WyncTrack_get_prop(ctx, pos_prop_id);
+
+	// exact, within tolerance, off by 4
+
+	Vector2i predicted[3] = { { 10, 10 }, { 20, 20 }, { 30, 30 } };
+	Vector2i confirmed[3] = { { 10, 10 }, { 21, 20 }, { 34, 30 } };
+	for (int i = 0; i < 3; ++i) {
+		i32 tick = 100 + i;
+		WyncProp_PredState *slot = &prop->co_xtrap.pred_history
+			[tick & (PRED_STATE_HISTORY_SIZE -1)];
+		slot->tick = tick;
+		WyncState_set_from_buffer(&slot->state, sizeof(Vector2i), &predicted[i]);
+		WyncStore_prop_state_buffer_insert_copy(
+			ctx, prop, tick, sizeof(Vector2i), &confirmed[i]);
+	}
+
+	TEST_TRUE(WyncXtrap_prop_prediction_matches(ctx, prop, pos_prop_id, 100));
+	TEST_TRUE(WyncXtrap_prop_prediction_matches(ctx, prop, pos_prop_id, 101));
+	TEST_FALSE(WyncXtrap_prop_prediction_matches(ctx, prop, pos_prop_id, 102));
+
+	WyncStat_PredictionError pred_error = { 0 };
+	TEST_INT(WyncStat_get_prop_prediction_error(
+		ctx, pos_prop_id, &pred_error), OK);
+	TEST_UINT(pred_error.predictions_checked, 3);
+	TEST_UINT(pred_error.mispredictions, 1);
+	TEST_UINT(pred_error.error_samples, 3);
+	TEST_TRUE(pred_error.error_max == 4.f);
+	TEST_TRUE(fabsf(pred_error.error_mean - 5.f / 3.f) < 0.001f);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
+/// Rollbacks that don't fit the re-simulation budget are deferred whole
+void test_resimulation_budget (void) {
+	TESTS_INIT();
+	util_reset_state();
+	util_setup_server_and_client();
+
+	WyncCtx *ctx = client_gs.wctx;
+	CoPredictionData *p = &ctx->co_pred;
+	WyncXtrap_set_resimulation_budget(ctx, 4);
+	p->cycle_first_new_tick = 110;
+
+	// entity 1 re-simulates 2 ticks. Entity 2 would need 9 but the cycle
+	// only goes 4 ticks back, it's not re-simulated from the middle
+
+	u32_DynArr_insert(&p->predicted_entity_ids, 1);
+	u32_DynArr_insert(&p->predicted_entity_ids, 2);
+	ConMap_set_pair(&p->entity_last_received_tick, 1, 107);
+	ConMap_set_pair(&p->entity_last_received_tick, 2, 100);
+	ConMap_set_pair(&p->entity_last_predicted_tick, 1, 107);
+	ConMap_set_pair(&p->entity_last_predicted_tick, 2, 100);
+
+	for (i32 tick = 106; tick < 112; ++tick) {
+		WyncXtrap_regular_entities_to_predict(ctx, tick);
+	}
+
+	TEST_UINT(ctx->co_metrics.xtrap_entities_over_budget, 1);
+	TEST_UINT(ctx->co_metrics.xtrap_entity_ticks_resimulated, 2);
+	TEST_UINT(ctx->co_metrics.xtrap_entity_ticks_simulated, 6);
+	TEST_UINT(p->resim_budget_used, 2);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
+/// @returns amount of the entity's props in a flat predicted prop list
+static uint util_predicted_entity_props (
+	WyncCtx *ctx, uint entity_id, bool received, uint *out_prop_ids
+) {
+	CoPredictionData *p = &ctx->co_pred;
+	i32 index = -1;
+	if (ConMap_get(&p->predicted_entity_index, entity_id, &index) != OK) {
+		return 0;
+	}
+	u32_DynArr *offsets = received ?
+		&p->predicted_received_prop_offsets : &p->predicted_xtrap_prop_offsets;
+	u32_DynArr *prop_ids = received ?
+		&p->predicted_received_prop_ids : &p->predicted_xtrap_prop_ids;
+
+	uint amount = 0;
+	for (u32 i = offsets->items[index]; i < offsets->items[index +1]; ++i) {
+		out_prop_ids[amount++] = prop_ids->items[i];
+	}
+	return amount;
+}
+
+
+/// The flat lists of predicted entity props follow the filter rebuilds
+void test_predicted_entity_props_cache (void) {
+	TESTS_INIT();
+	util_reset_state();
+	util_setup_server_and_client();
+	util_client_joins_server();
+
+	WyncCtx *ctx = client_gs.wctx;
+	CoPredictionData *p = &ctx->co_pred;
+	uint pos_prop_ids[4], input_prop_ids[4];
+
+	// entity 1 predicts it's own input, entity 2 only it's position
+
+	for (uint id = 1; id <= 2; ++id) {
+		TEST_INT(WyncTrack_track_entity(ctx, id, 0), OK);
+		util_setup_tracking_ball(
+			&client_gs, id, &pos_prop_ids[id], &input_prop_ids[id], false);
+		TEST_INT(WyncProp_enable_prediction(ctx, pos_prop_ids[id]), OK);
+	}
+	TEST_INT(WyncProp_enable_prediction(ctx, input_prop_ids[1]), OK);
+	ConMap_set_pair(&ctx->co_clientauth.client_owns_prop[
+		ctx->common.my_peer_id], input_prop_ids[1], true);
+	util_force_WyncWrapper_client_filter_prop_ids(ctx);
+
+	uint prop_ids[8];
+	TEST_UINT(p->predicted_entity_ids.size, 2);
+	TEST_UINT(p->predicted_xtrap_prop_offsets.size, 3);
+	TEST_UINT(p->predicted_received_prop_offsets.size, 3);
+
+	TEST_UINT(util_predicted_entity_props(ctx, 1, false, prop_ids), 2);
+	TEST_UINT(util_predicted_entity_props(ctx, 1, true, prop_ids), 1);
+	TEST_UINT(prop_ids[0], pos_prop_ids[1]);
+	TEST_UINT(util_predicted_entity_props(ctx, 2, false, prop_ids), 1);
+	TEST_UINT(prop_ids[0], pos_prop_ids[2]);
+	TEST_UINT(util_predicted_entity_props(ctx, 2, true, prop_ids), 2);
+
+	// rebuild, entity 1 no longer owns it's input and entity 3 joins
+
+	ConMap_remove_by_key(&ctx->co_clientauth.client_owns_prop[
+		ctx->common.my_peer_id], input_prop_ids[1]);
+	TEST_INT(WyncTrack_track_entity(ctx, 3, 0), OK);
+	util_setup_tracking_ball(
+		&client_gs, 3, &pos_prop_ids[3], &input_prop_ids[3], false);
+	TEST_INT(WyncProp_enable_prediction(ctx, pos_prop_ids[3]), OK);
+	util_force_WyncWrapper_client_filter_prop_ids(ctx);
+
+	TEST_UINT(p->predicted_entity_ids.size, 3);
+	TEST_UINT(util_predicted_entity_props(ctx, 1, false, prop_ids), 2);
+	TEST_UINT(util_predicted_entity_props(ctx, 1, true, prop_ids), 2);
+	TEST_UINT(util_predicted_entity_props(ctx, 2, false, prop_ids), 1);
+	TEST_UINT(prop_ids[0], pos_prop_ids[2]);
+	TEST_UINT(util_predicted_entity_props(ctx, 3, false, prop_ids), 1);
+	TEST_UINT(prop_ids[0], pos_prop_ids[3]);
+	TEST_UINT(util_predicted_entity_props(ctx, 3, true, prop_ids), 2);
+
+	for (uint i = 0; i < p->predicted_entity_ids.size; ++i) {
+		i32 index = -1;
+		ConMap_get(&p->predicted_entity_index,
+			p->predicted_entity_ids.items[i], &index);
+		TEST_INT(index, (int)i);
+	}
+	TEST_UINT(p->predicted_xtrap_prop_offsets.items[3],
+		p->predicted_xtrap_prop_ids.size);
+	TEST_UINT(p->predicted_received_prop_offsets.items[3],
+		p->predicted_received_prop_ids.size);
+	TEST_UINT(p->predicted_received_prop_ids.size, 6);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
+static void util_client_receive_snap (
+	WyncCtx *ctx, uint prop_id, uint tick, Vector2i value
+) {
+	WyncSnap snap = { prop_id, { sizeof(Vector2i), &value } };
+	WyncPktSnap pkt = { .tick = tick, .snap_amount = 1, .snaps = &snap };
+	WyncStore_handle_pkt_prop_snap(ctx, pkt);
+}
+
+
+static void util_client_receive_inputs (
+	WyncCtx *ctx, uint prop_id, uint first_tick, uint amount
+) {
+	Vector2i value = { 0, 0 };
+	WyncTickDecorator inputs[8];
+	for (uint i = 0; i < amount; ++i) {
+		inputs[i] = (WyncTickDecorator) {
+			first_tick + i, { sizeof(Vector2i), &value } };
+	}
+	WyncPktInputs pkt = { prop_id, amount, inputs };
+	WyncStore_client_handle_pkt_inputs(ctx, pkt);
+}
+
+
+static i32 util_entity_last_received_tick (WyncCtx *ctx, uint entity_id) {
+	i32 tick = -2;
+	ConMap_get(&ctx->co_pred.entity_last_received_tick, entity_id, &tick);
+	return tick;
+}
+
+
+/// The entity's last received tick is the min over it's props latest tick
+void test_entity_last_received_tick (void) {
+	TESTS_INIT();
+	util_reset_state();
+	util_setup_server_and_client();
+	util_client_joins_server();
+
+	WyncCtx *ctx = client_gs.wctx;
+	uint actor_id = 2;
+	uint pos_prop_id = 999, input_prop_id = 999;
+	TEST_INT(WyncTrack_track_entity(ctx, actor_id, 0), OK);
+	util_setup_tracking_ball(
+		&client_gs, actor_id, &pos_prop_id, &input_prop_id, false);
+	TEST_INT(WyncProp_enable_prediction(ctx, pos_prop_id), OK);
+	TEST_INT(WyncProp_enable_prediction(ctx, input_prop_id), OK);
+	util_force_WyncWrapper_client_filter_prop_ids(ctx);
+	TEST_UINT(ctx->co_pred.predicted_received_prop_ids.size, 2);
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), -1);
+
+	// props without state yet don't hold the entity back
+
+	util_client_receive_snap(ctx, pos_prop_id, 100, (Vector2i) { 1, 1 });
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), 100);
+	util_client_receive_inputs(ctx, input_prop_id, 100, 1);
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), 100);
+
+	// partial snap, the input is still behind
+
+	util_client_receive_snap(ctx, pos_prop_id, 102, (Vector2i) { 2, 2 });
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), 100);
+
+	// resent inputs only count their new ticks
+
+	util_client_receive_inputs(ctx, input_prop_id, 100, 3);
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), 102);
+	util_client_receive_inputs(ctx, input_prop_id, 100, 3);
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), 102);
+
+	// duplicated and out of order snaps don't move it
+
+	util_client_receive_snap(ctx, pos_prop_id, 102, (Vector2i) { 2, 2 });
+	util_client_receive_snap(ctx, pos_prop_id, 101, (Vector2i) { 3, 3 });
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), 102);
+
+	// props never sharing a tick still advance it
+
+	util_client_receive_snap(ctx, pos_prop_id, 104, (Vector2i) { 4, 4 });
+	util_client_receive_inputs(ctx, input_prop_id, 103, 3);
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), 104);
+	util_client_receive_snap(ctx, pos_prop_id, 106, (Vector2i) { 5, 5 });
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), 105);
+
+	// the cache rebuild reseeds from the received state
+
+	util_force_WyncWrapper_client_filter_prop_ids(ctx);
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), 105);
+	util_client_receive_inputs(ctx, input_prop_id, 106, 1);
+	TEST_INT(util_entity_last_received_tick(ctx, actor_id), 106);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
+/// Only entities whose received state differs from the prediction are
+/// rolled back
+void test_diverged_rollback (void) {
+	TESTS_INIT();
+	util_reset_state();
+	util_setup_server_and_client();
+	util_client_joins_server();
+
+	WyncCtx *ctx = client_gs.wctx;
+	uint ball_ids[] = { 1, 2 };
+	uint pos_prop_ids[2];
+	Vector2i predicted[] = { { 10, 10 }, { 20, 20 } };
+	Vector2i confirmed[] = { { 10, 10 }, { 25, 20 } };
+
+	for (uint k = 0; k < 2; ++k) {
+		uint input_prop_id;
+		TEST_INT(WyncTrack_track_entity(ctx, ball_ids[k], 0), OK);
+		util_setup_tracking_ball(
+			&client_gs, ball_ids[k], &pos_prop_ids[k], &input_prop_id, false);
+		TEST_INT(WyncProp_enable_prediction(ctx, pos_prop_ids[k]), OK);
+	}
+	util_force_WyncWrapper_client_filter_prop_ids(ctx);
+
+	// both entities predicted up to tick 105
+
+	for (uint k = 0; k < 2; ++k) {
+		WyncProp *prop = WyncTrack_get_prop(ctx, pos_prop_ids[k]);
+		WyncProp_PredState *slot = &prop->co_xtrap.pred_history
+			[100 & (PRED_STATE_HISTORY_SIZE -1)];
+		slot->tick = 100;
+		WyncState_set_from_buffer(
+			&slot->state, sizeof(Vector2i), &predicted[k]);
+		ConMap_set_pair(&ctx->co_pred.entity_last_predicted_tick,
+			ball_ids[k], 105);
+		client_gs.balls[ball_ids[k]].position = (Vector2i) { 99, 99 };
+
+		util_client_receive_snap(ctx, pos_prop_ids[k], 100, confirmed[k]);
+	}
+
+	WyncState_reset_props_to_latest_value(ctx);
+
+	TEST_UINT(ctx->co_pred.diverged_entity_ids.size, 1);
+	TEST_UINT(ctx->co_pred.diverged_entity_ids.items[0], ball_ids[1]);
+
+	// the one predicted right keeps it's predicted state
+
+	i32 last_predicted_tick = -1;
+	ConMap_get(&ctx->co_pred.entity_last_predicted_tick,
+		ball_ids[0], &last_predicted_tick);
+	TEST_INT(last_predicted_tick, 105);
+	TEST_INT(client_gs.balls[ball_ids[0]].position.x, 99);
+
+	ConMap_get(&ctx->co_pred.entity_last_predicted_tick,
+		ball_ids[1], &last_predicted_tick);
+	TEST_INT(last_predicted_tick, 100);
+	TEST_INT(client_gs.balls[ball_ids[1]].position.x, 25);
+	TEST_INT(client_gs.balls[ball_ids[1]].position.y, 20);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
 /// Server sends snapshot to Client
 void test_lerp_canonic_state (void) {
 	TESTS_INIT();
@@ -1065,6 +1855,260 @@ void test_lerp_canonic_state (void) {
 }
 
 
+static int util_chunk_block_at_tick (
+	WyncCtx *ctx, uint prop_id, i32 tick, uint x
+) {
+	WyncProp *prop = WyncTrack_get_prop(ctx, prop_id);
+	WyncState state = WyncTimewarp_prop_state_get(prop, tick, 0);
+	if (state.data == NULL) { return -1; }
+	return ((Block*)state.data)[x * CHUNK_HEIGHT_BLOCKS].type;
+}
+
+
+/// Compressed timewarp history: every tick of the window decodes back and it
+/// takes less memory than keeping the whole window
+void test_timewarp_compressed_history (void) {
+	TESTS_INIT();
+	util_reset_state();
+	util_setup_server_and_client();
+
+	WyncCtx *ctx = server_gs.wctx;
+	uint chunk_id = 1;
+	Chunk *chunk = &server_gs.chunks[chunk_id];
+	uint blocks_prop_id = 999;
+	TEST_INT(WyncTrack_track_entity(ctx, chunk_id, 0), OK);
+	TEST_INT(WyncTrack_prop_register_minimal(
+		ctx, chunk_id, "blocks", WYNC_PROP_TYPE_STATE, &blocks_prop_id), OK);
+	WyncWrapper_set_prop_callbacks(
+		ctx,
+		blocks_prop_id,
+		(WyncWrapper_UserCtx) { .ctx = chunk, .type_size = sizeof(Chunk) },
+		chunk_instance_get_blocks,
+		chunk_instance_set_blocks
+	);
+
+	uint keyframe_interval = 8;
+	TEST_INT(WyncTimewarp_set_compressed_history(ctx, keyframe_interval), OK);
+	TEST_INT(WyncProp_enable_timewarp(ctx, blocks_prop_id), OK);
+	util_force_WyncWrapper_server_filter_prop_ids(ctx);
+
+	// server, one block changes every tick
+
+	u32 window = ctx->max_tick_history_timewarp;
+	i32 first_tick = (i32)WyncClock_get_ticks(ctx) +1;
+	for (u32 i = 0; i < window * 2; ++i) {
+		WyncClock_advance_ticks(ctx);
+		chunk->blocks[i % CHUNK_WIDTH_BLOCKS][0].type = (int)i +1;
+		WyncTimewarp_cache_current_state_timewarpable_props(ctx);
+	}
+	i32 last_tick = (i32)WyncClock_get_ticks(ctx);
+
+	WyncProp *prop = WyncTrack_get_prop(ctx, blocks_prop_id);
+	u32 window_bytes = window * (u32)sizeof(chunk->blocks);
+	TEST_TRUE(WyncTimewarp_prop_history_bytes(prop) < window_bytes / 2);
+
+	// every tick in the window, across keyframe boundaries
+
+	bool all_decoded = true;
+	for (i32 tick = last_tick - (i32)window +1; tick <= last_tick; ++tick) {
+		i32 i = tick - first_tick;
+		all_decoded &= util_chunk_block_at_tick(
+			ctx, blocks_prop_id, tick, (u32)i % CHUNK_WIDTH_BLOCKS) == i +1;
+		all_decoded &= util_chunk_block_at_tick(
+			ctx, blocks_prop_id, tick, (u32)(i -1) % CHUNK_WIDTH_BLOCKS) == i;
+	}
+	TEST_TRUE(all_decoded);
+
+	i32 keyframe_tick = last_tick - 40;
+	keyframe_tick -= keyframe_tick % (i32)keyframe_interval;
+	TEST_TRUE(WyncState_prop_state_buffer_get(prop, keyframe_tick).data == NULL);
+	for (i32 tick = keyframe_tick -1; tick <= keyframe_tick +1; ++tick) {
+		i32 i = tick - first_tick;
+		TEST_INT(WyncTimewarp_warp_to_tick(ctx, (u32)tick, 0), OK);
+		TEST_INT(chunk->blocks[i % CHUNK_WIDTH_BLOCKS][0].type, i +1);
+		WyncTimewarp_restore_present_state(ctx);
+		TEST_INT(chunk->blocks[(last_tick - first_tick) % CHUNK_WIDTH_BLOCKS][0]
+			.type, last_tick - first_tick +1);
+	}
+
+	// ticks outside the window aren't kept
+
+	i32 old_tick = last_tick - (i32)prop->co_tw.record_ticks;
+	TEST_TRUE(WyncTimewarp_prop_state_get(prop, old_tick, 0).data == NULL);
+	TEST_TRUE(WyncTimewarp_prop_state_get(prop, last_tick +1, 0).data == NULL);
+
+	// the latest tick extracted again takes the new state, and the next delta
+	// builds on it
+
+	chunk->blocks[0][1].type = 77;
+	WyncTimewarp_cache_current_state_timewarpable_props(ctx);
+	i32 rerecorded_tick = last_tick;
+	for (u32 i = 0; i < 16; ++i) {
+		WyncClock_advance_ticks(ctx);
+		chunk->blocks[1][1].type = (int)i;
+		WyncTimewarp_cache_current_state_timewarpable_props(ctx);
+	}
+	TEST_TRUE(WyncState_prop_state_buffer_get(
+		prop, rerecorded_tick).data == NULL);
+	WyncState state = WyncTimewarp_prop_state_get(prop, rerecorded_tick, 0);
+	TEST_TRUE(state.data != NULL);
+	TEST_INT(((Block*)state.data)[1].type, 77);
+	TEST_INT(((Block*)state.data)[CHUNK_HEIGHT_BLOCKS +1].type, 0);
+	state = WyncTimewarp_prop_state_get(prop, rerecorded_tick +1, 1);
+	TEST_TRUE(state.data != NULL);
+	TEST_INT(((Block*)state.data)[1].type, 77);
+	TEST_INT(((Block*)state.data)[CHUNK_HEIGHT_BLOCKS +1].type, 0);
+	state = WyncTimewarp_prop_state_get(prop, rerecorded_tick +2, 0);
+	TEST_INT(((Block*)state.data)[CHUNK_HEIGHT_BLOCKS +1].type, 1);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
+typedef struct {
+	float position[3];
+	float extents[3];
+} Hitbox;
+
+
+static uint32_t hitbox_get_into (
+	WyncWrapper_UserCtx ctx, void *dst, uint32_t capacity
+) {
+	if (ctx.type_size != sizeof(Hitbox) || capacity < sizeof(Hitbox)) {
+		return 0;
+	}
+	memcpy(dst, ctx.ctx, sizeof(Hitbox));
+	return sizeof(Hitbox);
+}
+
+
+/// Small props don't pay more for the compressed history than for keeping
+/// the whole window
+void test_timewarp_compressed_small_prop (void) {
+	TESTS_INIT();
+	util_reset_state();
+	util_setup_server_and_client();
+
+	WyncCtx *ctx = server_gs.wctx;
+	Hitbox hitbox = { .extents = { 0.5f, 1.8f, 0.5f } };
+	WyncWrapper_UserCtx user_ctx = { .ctx = &hitbox, .type_size = sizeof(Hitbox) };
+
+	// same hitbox, one keeps the window in the state buffer
+
+	uint prop_ids[2] = { 999, 999 };
+	uint keyframe_intervals[2] = { 0, 8 };
+	for (uint i = 0; i < 2; ++i) {
+		TEST_INT(WyncTrack_track_entity(ctx, 10 + i, 0), OK);
+		TEST_INT(WyncTrack_prop_register_sized(ctx, 10 + i, "hitbox",
+			WYNC_PROP_TYPE_STATE, sizeof(Hitbox), &prop_ids[i]), OK);
+		WyncWrapper_set_prop_callbacks_into(
+			ctx, prop_ids[i], user_ctx, hitbox_get_into, NULL);
+		TEST_INT(WyncTimewarp_set_compressed_history(
+			ctx, keyframe_intervals[i]), OK);
+		TEST_INT(WyncProp_enable_timewarp(ctx, prop_ids[i]), OK);
+	}
+	util_force_WyncWrapper_server_filter_prop_ids(ctx);
+
+	u32 window = ctx->max_tick_history_timewarp;
+	i32 first_tick = (i32)WyncClock_get_ticks(ctx) +1;
+	for (u32 i = 0; i < window * 2; ++i) {
+		WyncClock_advance_ticks(ctx);
+		hitbox.position[0] = (float)i * 0.25f;
+		WyncTimewarp_cache_current_state_timewarpable_props(ctx);
+	}
+	i32 last_tick = (i32)WyncClock_get_ticks(ctx);
+
+	WyncProp *plain_prop = WyncTrack_get_prop(ctx, prop_ids[0]);
+	WyncProp *prop = WyncTrack_get_prop(ctx, prop_ids[1]);
+	TEST_TRUE(plain_prop->co_tw.records == NULL);
+	TEST_TRUE(prop->co_tw.records != NULL);
+	TEST_TRUE(WyncTimewarp_prop_history_bytes(prop)
+		< WyncTimewarp_prop_history_bytes(plain_prop));
+
+	bool all_decoded = true;
+	for (i32 tick = last_tick - (i32)window +1; tick <= last_tick; ++tick) {
+		WyncState state = WyncTimewarp_prop_state_get(prop, tick, 0);
+		all_decoded &= state.data != NULL
+			&& state.data_size == sizeof(Hitbox)
+			&& ((Hitbox*)state.data)->position[0]
+				== (float)(tick - first_tick) * 0.25f
+			&& ((Hitbox*)state.data)->extents[1] == 1.8f;
+	}
+	TEST_TRUE(all_decoded);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
+/// Lazy timewarp only warps and restores the requested entities
+void test_timewarp_lazy (void) {
+	TESTS_INIT();
+	util_reset_state();
+	util_setup_server_and_client();
+
+	WyncCtx *ctx = server_gs.wctx;
+	uint ball_ids[] = { 1, 2 };
+	for (uint k = 0; k < 2; ++k) {
+		uint pos_prop_id, input_prop_id;
+		TEST_INT(WyncTrack_track_entity(ctx, ball_ids[k], 0), OK);
+		util_setup_tracking_ball(
+			&server_gs, ball_ids[k], &pos_prop_id, &input_prop_id, false);
+		TEST_INT(WyncProp_enable_timewarp(ctx, pos_prop_id), OK);
+	}
+	util_force_WyncWrapper_server_filter_prop_ids(ctx);
+
+	Ball *ball_a = &server_gs.balls[ball_ids[0]];
+	Ball *ball_b = &server_gs.balls[ball_ids[1]];
+
+	u32 first_tick = WyncClock_get_ticks(ctx) +1;
+	for (int i = 0; i < 20; ++i) {
+		WyncClock_advance_ticks(ctx);
+		ball_a->position = (Vector2i) { 100 + i, 1 };
+		ball_b->position = (Vector2i) { 200 + i, 2 };
+		WyncTimewarp_cache_current_state_timewarpable_props(ctx);
+	}
+	u32 tick_a = first_tick + 5;
+	u32 tick_b = first_tick + 10;
+
+	// only the requested entity is warped and restored
+
+	uint warped_entity_ids[] = { ball_ids[0] };
+	TEST_INT(WyncTimewarp_warp_entities_to_tick(
+		ctx, warped_entity_ids, 1, tick_a, 0), OK);
+	TEST_INT(ball_a->position.x, 105);
+	TEST_INT(ball_b->position.x, 219);
+	TEST_UINT(u32_DynArr_get_size(&ctx->co_timewarp.dirty_entity_ids), 1);
+	WyncTimewarp_restore_present_state(ctx);
+	TEST_INT(ball_a->position.x, 119);
+	TEST_INT(ball_b->position.x, 219);
+	TEST_UINT(u32_DynArr_get_size(&ctx->co_timewarp.dirty_entity_ids), 0);
+
+	uint untracked_entity_ids[] = { ball_ids[1], 3 };
+	TEST_INT(WyncTimewarp_warp_entities_to_tick(
+		ctx, untracked_entity_ids, 2, tick_b, 0), -1);
+	TEST_INT(ball_b->position.x, 210);
+	WyncTimewarp_restore_present_state(ctx);
+	TEST_INT(ball_b->position.x, 219);
+
+	// whole world warp, then a lazy warp on top. Restoring undoes both
+
+	TEST_INT(WyncTimewarp_warp_to_tick(ctx, tick_a, 0), OK);
+	TEST_INT(ball_a->position.x, 105);
+	TEST_INT(ball_b->position.x, 205);
+	TEST_INT(WyncTimewarp_warp_entities_to_tick(
+		ctx, warped_entity_ids, 1, tick_b, 0), OK);
+	TEST_INT(ball_a->position.x, 110);
+	TEST_INT(ball_b->position.x, 205);
+	WyncTimewarp_restore_present_state(ctx);
+	TEST_INT(ball_a->position.x, 119);
+	TEST_INT(ball_b->position.x, 219);
+	TEST_FALSE(ctx->co_timewarp.world_warped);
+	TEST_UINT(u32_DynArr_get_size(&ctx->co_timewarp.dirty_entity_ids), 0);
+
+	TESTS_SHOW_RESULTS();
+}
+
+
 // TODO: Improve tests for
 // * Inputs, client ownership, extrapolation, interpolation?
 // * Despawning
@@ -1075,11 +2119,24 @@ void test_lerp_canonic_state (void) {
 
 
 int main (void) {
+	test_ring_insert_sorted();
+	test_state_history_index();
 	test_join();
 	test_tracking();
 	test_snapshot();
+	test_sized_prop();
+	test_input_delta_encoding();
+	test_lerp_kernels();
 	test_client_authority_inputs();
 	test_extrapolation();
+	test_prediction_error();
+	test_resimulation_budget();
+	test_predicted_entity_props_cache();
+	test_entity_last_received_tick();
+	test_diverged_rollback();
 	test_lerp_canonic_state();
+	test_timewarp_compressed_history();
+	test_timewarp_compressed_small_prop();
+	test_timewarp_lazy();
 	return SIMPLE_TEST_CODE;
 }
@@ -27,11 +27,42 @@ typedef struct {
 
 typedef WyncWrapper_Data (*WyncWrapper_Getter)(WyncWrapper_UserCtx ctx);
 
+/// Getter variant that writes the state into library owned memory.
+/// @returns Amount of bytes written, 0 if failed or it doesn't fit 'capacity'
+typedef uint32_t (*WyncWrapper_GetterInto)(
+    WyncWrapper_UserCtx ctx, void *dst, uint32_t capacity);
+
 typedef void (*WyncWrapper_Setter)(WyncWrapper_UserCtx, WyncWrapper_Data data);
 
+/// Batch getter variant, writes one state per user context into 'dsts'.
+/// 'inout_sizes' holds the capacity of each destination, overwrite it with
+/// the amount of bytes written (0 if failed).
+typedef void (*WyncWrapper_BatchGetter)(
+    WyncWrapper_UserCtx *ctxs, void **dsts, uint32_t *inout_sizes,
+    uint32_t amount);
+
+/// Batch setter variant, sets one state per user context
+typedef void (*WyncWrapper_BatchSetter)(
+    WyncWrapper_UserCtx *ctxs, WyncWrapper_Data *datas, uint32_t amount);
+
 typedef WyncWrapper_Data (*WyncWrapper_LerpFunc)(
     WyncWrapper_Data from, WyncWrapper_Data to, float delta);
 
+/// @returns Distance between two states of the same prop, e.g. in meters
+typedef float (*WyncWrapper_DistanceFunc)(
+    WyncWrapper_Data predicted, WyncWrapper_Data confirmed);
+
+/// Built-in interpolation kernels, they work in place on the stored bytes
+/// without allocating. States must be packed arrays of the given element.
+enum WYNC_LERP_KERNEL {
+    WYNC_LERP_KERNEL_NONE,       // use the registered WyncWrapper_LerpFunc
+    WYNC_LERP_KERNEL_F32,        // float[N]
+    WYNC_LERP_KERNEL_I32,        // int32_t[N], e.g. fixed point, rounded
+    WYNC_LERP_KERNEL_QUAT_NLERP, // float[N][4], N packed quaternions (x, y, z, w)
+    WYNC_LERP_KERNEL_QUAT_SLERP, // float[N][4], N packed quaternions (x, y, z, w)
+    WYNC_LERP_KERNEL_AMOUNT
+};
+
 typedef struct {
     uint32_t event_type_id;
     WyncWrapper_Data data;
@@ -70,6 +101,39 @@ typedef struct {
 /// WYNC STATISTICS
 /// ---------------------------------------------------------------------------
 
+typedef struct {
+    uint32_t predictions_checked; // confirmed states compared to a prediction
+    uint32_t mispredictions;
+    // Error magnitude needs a distance function, see
+    // WyncProp_set_prediction_tolerance. Measured on every check
+    uint32_t error_samples;
+    float error_max;
+    float error_mean; // over error_samples
+} WyncStat_PredictionError;
+
+typedef struct {
+    // Last prediction cycle: entity ticks simulated, and how many of them
+    // were already predicted before (re-simulated after a rollback)
+    uint32_t entity_ticks_simulated;
+    uint32_t entity_ticks_resimulated;
+    uint32_t entities_over_budget; // see WyncXtrap_set_resimulation_budget
+    // totals
+    uint32_t predictions_checked;
+    uint32_t mispredictions;
+} WyncStat_Prediction;
+
+/// Client only. Prediction cost and accuracy, use it to tune what to predict
+void WyncStat_get_prediction_metrics(WyncCtx *ctx, WyncStat_Prediction *out);
+
+/// @returns error
+int32_t WyncStat_get_prop_prediction_error(
+    WyncCtx *ctx, uint32_t prop_id, WyncStat_PredictionError *out);
+
+/// Aggregate of the entity's predicted props
+/// @returns error
+int32_t WyncStat_get_entity_prediction_error(
+    WyncCtx *ctx, uint32_t entity_id, WyncStat_PredictionError *out);
+
 /// ---------------------------------------------------------------------------
 /// WYNC PACKET UTIL
 /// ---------------------------------------------------------------------------
@@ -289,6 +353,19 @@ int32_t WyncJoin_get_nete_peer_id_from_wync_peer_id(
 void WyncLerp_client_set_lerp_ms(
     WyncCtx *ctx, float server_tick_rate, uint32_t lerp_ms);
 
+/// Lets the client tune lerp_ms on it's own: the smallest delay that keeps
+/// the interpolation from running out of snapshots more often than
+/// 'underrun_target', given the measured snapshot jitter. The Server is
+/// informed of every change for timewarp. Overrides
+/// WyncLerp_client_set_lerp_ms while enabled.
+///
+/// @param min_ms Lower bound for lerp_ms
+/// @param max_ms Upper bound for lerp_ms. Pass 0 to disable
+/// @param underrun_target Accepted ratio [0, 1] of ticks without a newer
+///                        snapshot to interpolate to (e.g. 0.01)
+void WyncLerp_client_set_adaptive_lerp_ms(
+    WyncCtx *ctx, uint32_t min_ms, uint32_t max_ms, float underrun_target);
+
 /// Configures the maximum factor for interpolation. Describes how much the
 /// interpolation is allowed to extend (extrapolate) when data is missing. This
 /// range will be applied symmetrically: How much to go in the past, and how
@@ -298,6 +375,21 @@ void WyncLerp_client_set_lerp_ms(
 void WyncLerp_set_max_lerp_factor_symmetric(
     WyncCtx *ctx, float max_lerp_factor_symmetric);
 
+/// Enables dead reckoning for confirmed states: when the next snapshot is
+/// late, interpolated Props keep moving past the last state (along the last
+/// two states or the Hermite velocity) instead of stopping at
+/// max_lerp_factor_symmetric. Allows a smaller lerp_ms since the buffer
+/// doesn't have to cover the worst case jitter.
+///
+/// Call it before WyncLerp_client_set_lerp_ms so it's lower bound drops
+/// from two update intervals to one.
+///
+/// @param max_ms How far past the last state to extrapolate. 0 disables it
+/// @param correction_ms Time to blend out the error once the late snapshot
+///                      arrives (WYNC_LERP_KERNEL_F32 types only)
+void WyncLerp_set_extrapolation(
+    WyncCtx *ctx, uint32_t max_ms, uint32_t correction_ms);
+
 /// Register a data type for performing interpolation.
 ///
 /// @param user_type_id User defined Identifier for this data type
@@ -307,6 +399,33 @@ void WyncLerp_set_max_lerp_factor_symmetric(
 void WyncLerp_register_lerp_type(
     WyncCtx *ctx, uint16_t user_type_id, WyncWrapper_LerpFunc lerp_func);
 
+/// Register a data type interpolated by a built-in kernel instead of a
+/// lerp function. Prefer it for common layouts (vectors, quaternions,
+/// fixed point), it doesn't allocate nor call back per prop.
+///
+/// @param user_type_id User defined Identifier for this data type
+///                     there is a limit of WYNC_MAX_USER_TYPES.
+/// @returns error
+int32_t WyncLerp_register_lerp_kernel(
+    WyncCtx *ctx, uint16_t user_type_id, enum WYNC_LERP_KERNEL kernel);
+
+/// Register a batch setter for a data type interpolated by a built-in
+/// kernel. Every frame it's props are lerped together and delivered in a
+/// single call, the data passed is only valid during the call. Props with a
+/// state size different from the rest of the batch use their own setter.
+///
+/// @returns error
+int32_t WyncLerp_register_batch_setter(
+    WyncCtx *ctx, uint16_t user_type_id, WyncWrapper_BatchSetter setter);
+
+/// Interpolates 'from' and 'to' with a built-in kernel into 'out', which
+/// must hold 'from.data_size' bytes.
+///
+/// @returns error
+int32_t WyncLerp_run_kernel(
+    enum WYNC_LERP_KERNEL kernel, WyncWrapper_Data from, WyncWrapper_Data to,
+    float delta, void *out);
+
 void WyncLerp_interpolate_all(WyncCtx *ctx, float delta_lerp_fraction);
 
 /// ---------------------------------------------------------------------------
@@ -318,6 +437,17 @@ void WyncLerp_interpolate_all(WyncCtx *ctx, float delta_lerp_fraction);
 /// @returns error
 int32_t WyncProp_enable_prediction(WyncCtx *ctx, uint32_t prop_id);
 
+/// Measures how far off predictions of this Prop land, for statistics.
+/// Predictions closer than 'epsilon' to the confirmed state count as correct
+/// and don't cause a rollback. By default only exact matches do.
+///
+/// @param distance_func Distance between two states of this Prop
+/// @param epsilon Pass 0 to only collect statistics
+/// @returns error
+int32_t WyncProp_set_prediction_tolerance(
+    WyncCtx *ctx, uint32_t prop_id, WyncWrapper_DistanceFunc distance_func,
+    float epsilon);
+
 /// Enable Interpolation for a specified Prop
 ///
 /// @param user_type_id Previously register lerp data type identifier.
@@ -330,6 +460,24 @@ int32_t WyncProp_enable_interpolation(
     WyncCtx *ctx, uint32_t prop_id, uint16_t user_data_type,
     WyncWrapper_Setter setter_lerp);
 
+enum WYNC_LERP_MODE {
+    WYNC_LERP_MODE_LINEAR,
+    WYNC_LERP_MODE_CATMULL_ROM, // curve through the snapshots around the pair
+    WYNC_LERP_MODE_HERMITE      // curve following a velocity prop
+};
+
+/// Sets how confirmed states of an interpolated Prop are blended. Cubic
+/// modes allow lower send rates for fast moving entities without jitter.
+/// They require the lerp type to use WYNC_LERP_KERNEL_F32, predicted states
+/// and timewarp stay linear.
+///
+/// @param velocity_prop_id (HERMITE only) Prop with the same layout holding
+///                         the velocity in units per second
+/// @returns error
+int32_t WyncProp_set_interpolation_mode(
+    WyncCtx *ctx, uint32_t prop_id, enum WYNC_LERP_MODE mode,
+    uint32_t velocity_prop_id);
+
 /// ---------------------------------------------------------------------------
 /// WYNC SPAWN
 /// ---------------------------------------------------------------------------
@@ -409,6 +557,25 @@ int32_t WyncTrack_prop_register_minimal(
     WyncCtx *ctx, uint32_t entity_id, const char *name_id,
     enum WYNC_PROP_TYPE data_type, uint32_t *out_prop_id);
 
+/// Sets how many ticks of state history the prop keeps (rounded up to a
+/// power of two), by default it's derived from the prop's type and features:
+/// plain state props keep 2 ticks, interpolated or predicted ones
+/// REGULAR_PROP_CACHED_STATE_AMOUNT. Timewarpable props keep at least the
+/// timewarp window.
+/// Call it right after registering, stored history is discarded.
+/// @returns error
+int32_t WyncProp_set_history_depth(
+    WyncCtx *ctx, uint32_t prop_id, uint32_t depth);
+
+/// Registers a prop whose state never exceeds 'max_data_size' bytes.
+/// It's state history is preallocated as a single contiguous block.
+/// @param[out] out_prop_id
+/// @returns error
+int32_t WyncTrack_prop_register_sized(
+    WyncCtx *ctx, uint32_t entity_id, const char *name_id,
+    enum WYNC_PROP_TYPE data_type, uint32_t max_data_size,
+    uint32_t *out_prop_id);
+
 int32_t WyncTrack_entity_get_prop_id(
     WyncCtx *ctx, uint32_t entity_id, const char *prop_name_id,
     uint32_t *out_prop_id);
@@ -450,6 +617,24 @@ void WyncXtrap_termination(WyncCtx *ctx);
 
 bool WyncXtrap_allowed_to_predict_entity(WyncCtx *ctx, uint32_t entity_id);
 
+/// Caps how much re-simulation a prediction cycle may do after a rollback,
+/// keeps frame times stable after lag spikes. An entity is either fully
+/// re-simulated or, when it doesn't fit, it continues predicting from it's
+/// latest confirmed state.
+///
+/// @param max_entity_ticks Re-simulated ticks summed over all entities.
+///                         0 for unlimited (default)
+void WyncXtrap_set_resimulation_budget(
+    WyncCtx *ctx, uint32_t max_entity_ticks);
+
+/// Gets the state that was predicted for a tick, still owned by Wync. Only
+/// the last PRED_STATE_HISTORY_SIZE predicted ticks are kept.
+///
+/// @param out_state Valid until that tick is predicted again
+/// @returns error
+int32_t WyncXtrap_get_predicted_state(
+    WyncCtx *ctx, uint32_t prop_id, int32_t tick, WyncWrapper_Data *out_state);
+
 /// ---------------------------------------------------------------------------
 /// WYNC WRAPPER UTIL
 /// ---------------------------------------------------------------------------
@@ -458,6 +643,22 @@ void WyncWrapper_set_prop_callbacks(
     WyncCtx *ctx, uint32_t prop_id, WyncWrapper_UserCtx user_ctx,
     WyncWrapper_Getter getter, WyncWrapper_Setter setter);
 
+/// Same as WyncWrapper_set_prop_callbacks but with a getter that doesn't
+/// allocate. Pairs well with WyncTrack_prop_register_sized.
+void WyncWrapper_set_prop_callbacks_into(
+    WyncCtx *ctx, uint32_t prop_id, WyncWrapper_UserCtx user_ctx,
+    WyncWrapper_GetterInto getter_into, WyncWrapper_Setter setter);
+
+/// Registers callbacks that get/set all props named 'prop_name' of entities
+/// of type 'entity_type_id' in a single call.
+/// Only props registered with WyncTrack_prop_register_sized are batched.
+/// Each prop's user context is still set with WyncWrapper_set_prop_callbacks
+/// (getter and setter may be NULL).
+/// @returns error
+int32_t WyncWrapper_register_batch_callbacks(
+    WyncCtx *ctx, uint32_t entity_type_id, const char *prop_name,
+    WyncWrapper_BatchGetter getter, WyncWrapper_BatchSetter setter);
+
 /// ---------------------------------------------------------------------------
 /// WYNC DELTA SYNC
 /// ---------------------------------------------------------------------------
@@ -531,6 +732,14 @@ uint32_t WyncTimewarp_get_peer_lerp_ms(WyncCtx *ctx, uint32_t wync_peer_id);
 
 bool WyncTimewarp_can_we_timerwarp_to_this_tick(WyncCtx *ctx, uint32_t tick);
 
+/// Props enabling timewarp afterwards keep a keyframe every
+/// 'keyframe_interval' ticks and byte deltas in between instead of the full
+/// window of states. Only the ticks a warp reads get decoded.
+/// 0 keeps the full history.
+/// @returns error
+int WyncTimewarp_set_compressed_history(
+    WyncCtx *ctx, uint32_t keyframe_interval);
+
 void WyncTimewarp_cache_current_state_timewarpable_props(WyncCtx *ctx);
 
 int WyncTimewarp_warp_to_tick(WyncCtx *ctx, uint32_t tick, float delta_lerp_ms);
@@ -538,6 +747,15 @@ int WyncTimewarp_warp_to_tick(WyncCtx *ctx, uint32_t tick, float delta_lerp_ms);
 int WyncTimewarp_warp_entity_to_tick(
     WyncCtx *ctx, uint32_t entity_id, uint32_t tick_left, float lerp_delta_ms);
 
+/// Lazy alternative to WyncTimewarp_warp_to_tick, e.g. for the entities
+/// near a hit-scan ray
+/// @returns error
+int WyncTimewarp_warp_entities_to_tick(
+    WyncCtx *ctx, const uint32_t *entity_ids, uint32_t entity_amount,
+    uint32_t tick_left, float lerp_delta_ms);
+
+/// Restores only the entities warped since the last call, or every
+/// timewarpable prop after WyncTimewarp_warp_to_tick
 void WyncTimewarp_restore_present_state (WyncCtx *ctx);
 
 #endif // !WYNC_H
@@ -15,6 +15,9 @@
 // ============================================================
 
 
+#ifndef u8
+#define u8 uint8_t
+#endif
 #ifndef i16
 #define i16 int16_t
 #endif
@@ -419,19 +422,227 @@ static void WyncPktInputs_free (WyncPktInputs *pkt) {
 	pkt->amount = 0;
 }
 
+// Set on the input amount when the inputs are delta encoded. Consecutive
+// inputs are usually the same or differ in a few bytes, so instead of a
+// tick and a size per input the packet holds a base tick and records:
+// * REPEAT: 'count' inputs on the following ticks equal to the previous one
+// * RAW:    tick delta, size and bytes
+// * XOR:    tick delta and runs of (zeros, literals) of the XOR against the
+//           previous input, which has the same size
+#define WYNC_INPUTS_DELTA_BIT (1u << 31)
+
+// NOTE: Rename to PRED_INPUT_BUFFER_SIZE
+#define INPUT_BUFFER_SIZE 1024 // 2 ** 10
+
+enum WYNC_INPUT_RECORD {
+	WYNC_INPUT_RECORD_REPEAT,
+	WYNC_INPUT_RECORD_RAW,
+	WYNC_INPUT_RECORD_XOR,
+};
+
+/// @returns whether the inputs can be delta encoded: ascending ticks at most
+/// 255 ticks apart with non empty inputs of at most 65535 bytes
+static bool WyncPktInputs_is_delta_encodable (WyncPktInputs *pkt) {
+	for (u32 i = 0; i < pkt->amount; ++i) {
+		WyncTickDecorator *input = &pkt->inputs[i];
+		if (input->state.data_size == 0 || input->state.data_size > 0xFFFF
+			|| input->state.data == NULL) {
+			return false;
+		}
+		if (i > 0) {
+			u32 tick_delta = input->tick - pkt->inputs[i-1].tick;
+			if (input->tick <= pkt->inputs[i-1].tick || tick_delta > 0xFF) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/// @returns size in bytes of the XOR runs of 'a' against 'b'
+static u32 WyncPktInputs_xor_runs_size (u8 *a, u8 *b, u32 size) {
+	u32 total = 0;
+	u32 i = 0;
+	while (i < size) {
+		u32 zeros = 0, literals = 0;
+		while (i < size && zeros < 0xFF && a[i] == b[i]) { ++zeros; ++i; }
+		while (i < size && literals < 0xFF && a[i] != b[i]) { ++literals; ++i; }
+		total += 2 + literals;
+	}
+	return total;
+}
+
+static bool WyncPktInputs_write_delta (NeteBuffer *buff, WyncPktInputs *pkt) {
+	u32 base_tick = pkt->inputs[0].tick;
+	NETEBUFFER_WRITE_BYTES(buff, &base_tick, sizeof(u32));
+
+	u8 header[2];
+	u16 size;
+	WyncTickDecorator *input, *prev = NULL;
+
+	for (u32 i = 0; i < pkt->amount; ++i) {
+		input = &pkt->inputs[i];
+		u8 tick_delta = (u8)(input->tick - (prev ? prev->tick : base_tick));
+		size = (u16)input->state.data_size;
+
+		bool same_size = prev != NULL && prev->state.data_size == size;
+
+		// run of repeated inputs on consecutive ticks
+
+		if (same_size && tick_delta == 1
+			&& memcmp(input->state.data, prev->state.data, size) == 0) {
+			u32 count = 1;
+			while (i + count < pkt->amount && count < 0xFF) {
+				WyncTickDecorator *next = &pkt->inputs[i + count];
+				if (next->tick != input->tick + count
+					|| next->state.data_size != size
+					|| memcmp(next->state.data, input->state.data, size) != 0) {
+					break;
+				}
+				++count;
+			}
+			header[0] = WYNC_INPUT_RECORD_REPEAT;
+			header[1] = (u8)count;
+			NETEBUFFER_WRITE_BYTES(buff, header, 2);
+
+			i += count - 1;
+			prev = &pkt->inputs[i];
+			continue;
+		}
+
+		u8 *data = (u8*)input->state.data;
+		bool use_xor = same_size && WyncPktInputs_xor_runs_size(
+			data, (u8*)prev->state.data, size) < (u32)size + 2;
+
+		header[0] = use_xor ? WYNC_INPUT_RECORD_XOR : WYNC_INPUT_RECORD_RAW;
+		header[1] = tick_delta;
+		NETEBUFFER_WRITE_BYTES(buff, header, 2);
+
+		if (!use_xor) {
+			NETEBUFFER_WRITE_BYTES(buff, &size, sizeof(u16));
+			NETEBUFFER_WRITE_BYTES(buff, data, size);
+			prev = input;
+			continue;
+		}
+
+		u8 *prev_data = (u8*)prev->state.data;
+		u8 literal_bytes[0xFF];
+		u32 k = 0;
+		while (k < size) {
+			u8 run[2] = { 0, 0 };
+			while (k < size && run[0] < 0xFF && data[k] == prev_data[k]) {
+				++run[0]; ++k;
+			}
+			while (k < size && run[1] < 0xFF && data[k] != prev_data[k]) {
+				literal_bytes[run[1]] = data[k] ^ prev_data[k];
+				++run[1]; ++k;
+			}
+			NETEBUFFER_WRITE_BYTES(buff, run, 2);
+			if (run[1] > 0) {
+				NETEBUFFER_WRITE_BYTES(buff, literal_bytes, run[1]);
+			}
+		}
+		prev = input;
+	}
+	return true;
+}
+
+/// Allocates the inputs, they're freed with WyncPktInputs_free even on error
+static bool WyncPktInputs_read_delta (NeteBuffer *buff, WyncPktInputs *pkt) {
+	u32 tick;
+	NETEBUFFER_READ_BYTES(buff, &tick, sizeof(u32));
+
+	u8 header[2];
+	u16 size;
+	WyncTickDecorator *input, *prev = NULL;
+
+	u32 i = 0;
+	while (i < pkt->amount) {
+		NETEBUFFER_READ_BYTES(buff, header, 2);
+
+		if (header[0] == WYNC_INPUT_RECORD_REPEAT) {
+			u32 count = header[1];
+			if (prev == NULL || count == 0 || i + count > pkt->amount) {
+				return false;
+			}
+			for (u32 k = 0; k < count; ++k) {
+				input = &pkt->inputs[i++];
+				input->tick = ++tick;
+				input->state = WyncState_copy_from_buffer(
+					prev->state.data_size, prev->state.data);
+			}
+			prev = input;
+			continue;
+		}
+
+		input = &pkt->inputs[i++];
+		tick += header[1];
+		input->tick = tick;
+
+		if (header[0] == WYNC_INPUT_RECORD_RAW) {
+			NETEBUFFER_READ_BYTES(buff, &size, sizeof(u16));
+			if (size == 0) return false;
+			input->state.data_size = size;
+			input->state.data = calloc(1, size);
+			NETEBUFFER_READ_BYTES(buff, input->state.data, size);
+			prev = input;
+			continue;
+		}
+		if (header[0] != WYNC_INPUT_RECORD_XOR || prev == NULL) {
+			return false;
+		}
+
+		size = (u16)prev->state.data_size;
+		input->state = WyncState_copy_from_buffer(size, prev->state.data);
+		u8 *data = (u8*)input->state.data;
+		u8 literal_bytes[0xFF];
+		u32 k = 0;
+		while (k < size) {
+			u8 run[2];
+			NETEBUFFER_READ_BYTES(buff, run, 2);
+			if (k + run[0] + run[1] > size) return false;
+			k += run[0];
+			if (run[1] > 0) {
+				NETEBUFFER_READ_BYTES(buff, literal_bytes, run[1]);
+			}
+			for (u32 j = 0; j < run[1]; ++j) {
+				data[k++] ^= literal_bytes[j];
+			}
+		}
+		prev = input;
+	}
+	return true;
+}
+
 static bool WyncPktInputs_serialize (
 	bool is_reading,
 	NeteBuffer *buff,
 	WyncPktInputs *pkt
 ) {
 	NETEBUFFER_BYTES_SERIALIZE(is_reading, buff, &pkt->prop_id, sizeof(u32));
-	NETEBUFFER_BYTES_SERIALIZE(is_reading, buff, &pkt->amount, sizeof(u32));
+
+	u32 header = pkt->amount;
+	if (!is_reading && pkt->amount > 0
+		&& WyncPktInputs_is_delta_encodable(pkt)) {
+		header |= WYNC_INPUTS_DELTA_BIT;
+	}
+	NETEBUFFER_BYTES_SERIALIZE(is_reading, buff, &header, sizeof(u32));
 
 	if (is_reading) {
+		pkt->amount = header & ~WYNC_INPUTS_DELTA_BIT;
+		if (pkt->amount > INPUT_BUFFER_SIZE) {
+			pkt->amount = 0;
+			return false;
+		}
 		pkt->inputs = (WyncTickDecorator*)
 			calloc(sizeof(WyncTickDecorator), pkt->amount);
 	}
 
+	if (header & WYNC_INPUTS_DELTA_BIT) {
+		return is_reading ? WyncPktInputs_read_delta(buff, pkt)
+			: WyncPktInputs_write_delta(buff, pkt);
+	}
+
 	WyncTickDecorator *input = NULL;
 	for (u32 i = 0; i < pkt->amount; ++i) {
 		input = &pkt->inputs[i];
@@ -496,26 +707,65 @@ typedef struct {
 	WyncState data;
 } WyncSnap;
 
+// Set on a snap's prop_id when it's data size equals the previous snap's
+// one, in that case the size is omitted (e.g. runs of fixed size props)
+#define WYNC_SNAP_SAME_SIZE_BIT (1u << 31)
+
+/// @param prev_data_size Data size of the previous snap in the packet, 0 if
+/// there's none
 static bool WyncSnap_serialize(
 	bool is_reading,
 	NeteBuffer *buffer,
-	WyncSnap *snap
+	WyncSnap *snap,
+	u32 prev_data_size
 ) {
-	NETEBUFFER_BYTES_SERIALIZE(is_reading, buffer, &snap->prop_id, sizeof(u32));
-	if (!WyncState_serialize(is_reading, buffer, &snap->data))
-		{ return false; }
+	u32 header = snap->prop_id;
+	if (!is_reading && prev_data_size != 0
+		&& snap->data.data_size == prev_data_size) {
+		header |= WYNC_SNAP_SAME_SIZE_BIT;
+	}
+	NETEBUFFER_BYTES_SERIALIZE(is_reading, buffer, &header, sizeof(u32));
+
+	if (is_reading) {
+		snap->prop_id = header & ~WYNC_SNAP_SAME_SIZE_BIT;
+	}
+	if (!(header & WYNC_SNAP_SAME_SIZE_BIT)) {
+		if (!WyncState_serialize(is_reading, buffer, &snap->data))
+			{ return false; }
+		return true;
+	}
+
+	if (is_reading) {
+		snap->data.data_size = prev_data_size;
+		snap->data.data = calloc(1, prev_data_size);
+	}
+	NETEBUFFER_BYTES_SERIALIZE(
+		is_reading, buffer, snap->data.data, snap->data.data_size);
 	return true;
 }
 static void WyncSnap_free(WyncSnap *snap) {
 	WyncState_free(&snap->data);
 }
 
+// Server -> Client: highest tick up to which the server has every input
+// of a client owned input/event prop, older inputs don't need resending
+typedef struct {
+	u32 prop_id;
+	i32 tick;
+} WyncPktSnap_InputAck;
+
 typedef struct {
 	u32 tick;
 	u16 snap_amount;
 	WyncSnap *snaps;
+	u16 input_ack_amount;
+	WyncPktSnap_InputAck *input_acks;
 } WyncPktSnap;
 
+// Set on 'snap_amount' when input acks follow the snaps. Acks are written
+// as tick offsets from the packet's tick
+#define WYNC_SNAP_HAS_INPUT_ACKS_BIT (1u << 15)
+
 static bool WyncPktSnap_serialize(
 	bool is_reading,
 	NeteBuffer *buffer,
@@ -523,17 +773,53 @@ static bool WyncPktSnap_serialize(
 ) {
 	NETEBUFFER_BYTES_SERIALIZE(
 			is_reading, buffer, &pkt->tick, sizeof(u32));
+
+	u16 header = pkt->snap_amount;
+	if (!is_reading && (header & WYNC_SNAP_HAS_INPUT_ACKS_BIT)) {
+		return false; // snap_amount would collide with the flag
+	}
+	if (!is_reading && pkt->input_ack_amount > 0) {
+		header |= WYNC_SNAP_HAS_INPUT_ACKS_BIT;
+	}
 	NETEBUFFER_BYTES_SERIALIZE(
-			is_reading, buffer, &pkt->snap_amount, sizeof(u16));
+			is_reading, buffer, &header, sizeof(u16));
 	if (is_reading) {
+		pkt->snap_amount = header & ~WYNC_SNAP_HAS_INPUT_ACKS_BIT;
 		// TODO: limit
 		pkt->snaps = (WyncSnap*) 
 			calloc(sizeof(WyncSnap), pkt->snap_amount);
 	}
+	u32 prev_data_size = 0;
 	for (u16 i = 0; i < pkt->snap_amount; ++i) {
-		if (!WyncSnap_serialize(is_reading, buffer, &pkt->snaps[i])) {
+		if (!WyncSnap_serialize(
+			is_reading, buffer, &pkt->snaps[i], prev_data_size)) {
 			return false;
 		}
+		prev_data_size = pkt->snaps[i].data.data_size;
+	}
+
+	if (!(header & WYNC_SNAP_HAS_INPUT_ACKS_BIT)) {
+		return true;
+	}
+
+	NETEBUFFER_BYTES_SERIALIZE(
+			is_reading, buffer, &pkt->input_ack_amount, sizeof(u16));
+	if (is_reading) {
+		pkt->input_acks = (WyncPktSnap_InputAck*)
+			calloc(sizeof(WyncPktSnap_InputAck), pkt->input_ack_amount);
+	}
+	for (u16 i = 0; i < pkt->input_ack_amount; ++i) {
+		WyncPktSnap_InputAck *ack = &pkt->input_acks[i];
+		i16 tick_offset = (i16)MAX(-32768, MIN(32767,
+			ack->tick - (i32)pkt->tick));
+
+		NETEBUFFER_BYTES_SERIALIZE(
+				is_reading, buffer, &ack->prop_id, sizeof(u32));
+		NETEBUFFER_BYTES_SERIALIZE(
+				is_reading, buffer, &tick_offset, sizeof(i16));
+		if (is_reading) {
+			ack->tick = (i32)pkt->tick + tick_offset;
+		}
 	}
 	return true;
 }
@@ -542,8 +828,11 @@ static void WyncPktSnap_free(WyncPktSnap *pkt) {
 		WyncSnap_free(&pkt->snaps[i]);
 	}
 	free(pkt->snaps);
+	free(pkt->input_acks);
 	pkt->snaps = NULL;
 	pkt->snap_amount = 0;
+	pkt->input_acks = NULL;
+	pkt->input_ack_amount = 0;
 }
 
 typedef struct {
@@ -872,8 +1161,6 @@ static bool WyncEventList_serialize(
 // --------------------------------------------------------
 
 typedef struct {
-	bool just_received_new_state;
-
 	// Unified
 	// states           <state_id, state>
 	// statebff.state_id_to_tick <state_id, tick>
@@ -884,10 +1171,26 @@ typedef struct {
 	WyncState_RinBuf saved_states;
 	// RingBuffer<int, int>
 	i32_RinBuf state_id_to_tick;
-	// RingBuffer<int, int>
+	// Index <tick, state_id>, open addressing table twice the history size
 	i32_RinBuf tick_to_state_id;
 	// RingBuffer<int, int> (only for lerping)
 	i32_RinBuf state_id_to_local_tick;
+	// The four rings above share this single allocation
+	void *rings_block;
+
+	// Client owned input/event props, highest tick up to which the server has
+	// every input. Server: tracked on arrival. Client: last ack received.
+	// -1 if none
+	i32 input_ack_tick;
+	// (server) last ack sent to the owner client, -1 if none
+	i32 input_ack_tick_sent;
+
+	// Fixed size props: 'saved_states' slots point into a single slab of
+	// 'saved_states.size * slab_stride' bytes and new states are copied in
+	// place. States that don't fit the stride fall back to their own heap
+	// block. (slab == NULL) means every state is heap allocated.
+	u32 slab_stride;
+	char *slab;
 	
 	// Note. On predicted entities only the latest value is valid
 	// Last-In-First-Out (LIFO)
@@ -899,9 +1202,33 @@ typedef struct {
 // Extrapolation / Prediction
 // --------------------------------------------------------
 
+typedef struct {
+	i32 tick; // -1 = empty
+	WyncState state;
+} WyncProp_PredState;
+
+typedef struct {
+	i32 tick; // -1 = no state received yet
+	u32 props_at_tick; // received props whose latest tick is 'tick'
+} WyncXtrap_EntityMinTick;
+
 typedef struct {
 	Wync_NetTickData pred_curr;
 	Wync_NetTickData pred_prev;
+
+	// Ring <tick % PRED_STATE_HISTORY_SIZE, state predicted for that tick>.
+	// Compared against confirmed state: a match needs no rollback.
+	// Slots keep their allocation, fixed size states don't reallocate
+	WyncProp_PredState *pred_history;
+
+	// misprediction statistics, distances need
+	// WyncWrapperCtx.prop_pred_distance
+	float pred_tolerance;
+	u32 pred_checked;
+	u32 pred_mispredicted;
+	float pred_error_max;
+	float pred_error_sum;
+	u32 pred_error_samples;
 } WyncProp_Xtrap;
 
 
@@ -931,6 +1258,26 @@ typedef struct {
 	
 	WyncState lerp_left_state;
 	WyncState lerp_right_state;
+
+	// (confirmed states) The pair only changes when new state arrives or the
+	// target time reaches the right snapshot, at this timestamp
+	float lerp_next_boundary_ms;
+
+	// enum WYNC_LERP_MODE. Cubic modes blend with the tangents at the left
+	// and right states, float[2][N] scaled to the pair's interval
+	u8 lerp_mode;
+	bool lerp_tangents_ready;
+	u32 lerp_velocity_prop_id;
+	WyncState lerp_tangents;
+
+	// Dead reckoning. The last output past the right state is kept, once the
+	// pair moves the difference is blended out as a decaying offset
+	bool lerp_extrapolating;
+	bool lerp_correction_pending;
+	bool lerp_correcting;
+	float lerp_correction_start_ms;
+	WyncState lerp_extrapolated_state;
+	WyncState lerp_correction;
 } WyncProp_Lerp;
 
 
@@ -965,6 +1312,45 @@ typedef struct {
 
 } WyncProp_Rela;
 
+// Timewarp
+// --------------------------------------------------------
+
+#define WYNC_TIMEWARP_KEYFRAME_BIT (1u << 31)
+
+typedef struct {
+	i32 tick; // -1 = empty
+	u32 start; // arena offset, see WyncProp_Timewarp
+	// encoded size. WYNC_TIMEWARP_KEYFRAME_BIT: stored as is, otherwise XOR
+	// runs against the state at tick -1, which has the same size
+	u32 size_flags;
+} WyncTimewarp_Record;
+
+typedef struct {
+	// Ring <tick % record_ticks, record>. NULL: the state buffer keeps the
+	// whole timewarp window instead
+	WyncTimewarp_Record *records;
+	u32 record_ticks; // window plus the chain back to it's oldest keyframe
+	u32 keyframe_interval;
+
+	// Encoded records, a record never wraps around the end. A record is
+	// written after the previous one, or at 0 when it doesn't fit. Grows
+	// instead of overwriting the last 'record_ticks' records
+	char *arena;
+	u32 arena_size;
+	u32 arena_head; // offset after the last written record
+
+	// Last recorded state, the next delta is taken against it. 'prev_state'
+	// is the one before, the base when 'last_tick' is recorded again
+	i32 last_tick;
+	WyncState last_state;
+	i32 prev_tick;
+	WyncState prev_state;
+
+	// Decoded states, a warp reads up to two ticks at once
+	i32 decoded_tick[2];
+	WyncState decoded[2];
+} WyncProp_Timewarp;
+
 // Event consumed module
 // --------------------------------------------------------
 
@@ -979,8 +1365,24 @@ typedef struct {
 } WyncProp_Consumed;
 
 
+/// Hot prop flags, mirrored per prop_id in CoStateTrackingCommon.prop_flags
+enum WYNC_PROP_FLAG {
+	WYNC_PROP_FLAG_ENABLED                 = 1 << 0,
+	WYNC_PROP_FLAG_LERP                    = 1 << 1,
+	WYNC_PROP_FLAG_XTRAP                   = 1 << 2,
+	WYNC_PROP_FLAG_RELATIVE_SYNC           = 1 << 3,
+	WYNC_PROP_FLAG_CONSUMED_EVENTS         = 1 << 4,
+	WYNC_PROP_FLAG_TIMEWARP                = 1 << 5,
+	WYNC_PROP_FLAG_AUXILIAR                = 1 << 6,
+	// Only lives in prop_flags, there is no WyncProp counterpart
+	WYNC_PROP_FLAG_JUST_RECEIVED_NEW_STATE = 1 << 7,
+};
+
+
 typedef struct {
-	// Future: Create pseudo-ECS for prop components
+	// Note: The hot fields (enabled, prop_type, *_enabled) are mirrored into
+	// the parallel arrays at CoStateTrackingCommon, loops over many props
+	// should read those instead. See WyncTrack_prop_update_hot_flags
 
 	bool enabled;
 
@@ -998,11 +1400,18 @@ typedef struct {
 	// if is_auxiliar_prop: points to delta prop
 	u32 auxiliar_delta_events_prop_id; // -1
 
+	// Upper bound for the state size, declared by the user. 0 if unknown
+	u32 declared_data_size;
+
+	// State history size chosen by the user. 0: derived from features
+	u32 history_depth;
+
 	WyncProp_StateBuffer statebff;
 	WyncProp_Lerp        co_lerp;
 	WyncProp_Xtrap       co_xtrap;
 	WyncProp_Rela        co_rela;
 	WyncProp_Consumed    co_consumed;
+	WyncProp_Timewarp    co_tw;
 } WyncProp;
 
 
@@ -1029,13 +1438,19 @@ typedef struct {
 #define SERVER_PEER_ID 0
 
 #define ENTITY_ID_GLOBAL_EVENTS 700
-// NOTE: Rename to PRED_INPUT_BUFFER_SIZE
-#define INPUT_BUFFER_SIZE 1024 // 2 ** 10
 #define INPUT_AMOUNT_TO_SEND 20     // TODO: Make configurable
+#define INPUT_AMOUNT_TO_SEND_MIN 4  // redundancy on a lossless connection
+// clock requests per packet loss sample
+#define PACKET_LOSS_SAMPLE_SIZE 8
+// The server consumes inputs at it's current tick, it only needs to buffer
+// the ticks clients are ahead
+#define SERVER_INPUT_BUFFER_SIZE 128 // 2 ** 7
 
 #define MAX_PROPS 4096              // default to 2**16 (65536)
 #define MAX_DUMMY_PROP_TICKS_ALIVE 100 // 1000
 #define SERVER_TICK_RATE_SLIDING_WINDOW_SIZE 8
+#define PRED_STATE_HISTORY_SIZE 64 // power of two, covers the prediction window
+#define LERP_ADAPTIVE_WINDOW_TICKS 60
 #define ENTITY_ID_PROB_FOR_ENTITY_UPDATE_DELAY_TICKS 699
 #define MAX_CHANNELS 8
 
@@ -1140,6 +1555,16 @@ typedef struct {
 	
 	// Array<prop_id: int, WyncProp>
 	WyncProp *props;
+
+	// Hot prop data as parallel arrays (pseudo-ECS). Scanning these doesn't
+	// pull the (big) cold WyncProp components into cache.
+	// Array<prop_id: int, enum WYNC_PROP_FLAG (bitmask)>
+	u16 *prop_flags;
+	// Array<prop_id: int, enum WYNC_PROP_TYPE>
+	u8 *prop_type;
+	// Array<prop_id: int, entity_id: int>, (u32)-1 if none. Reverse of
+	// 'entity_has_props'
+	u32 *prop_entity_id;
 	
 	// SizedBufferList[int]
 	// Set[int]
@@ -1208,6 +1633,18 @@ typedef struct {
 	u32_DynArr filtered_regular_timewarpable_non_interpolable_prop_ids; 
 } CoFilterServer;
 
+typedef struct {
+	// Everything timewarpable was warped, restore all of it
+	bool world_warped;
+	// Entities warped since the last restore, only these get restored
+	u32_DynArr dirty_entity_ids;
+	// scratch, props of the dirty entities
+	u32_DynArr restore_prop_ids;
+	// scratch, a record is encoded here before going into it's prop arena
+	char *encode_scratch;
+	u32 encode_scratch_size;
+} CoTimewarp;
+
 typedef struct {
 	u32_DynArr type_input_event__owned_prop_ids;
 	u32_DynArr type_input_event__predicted_owned_prop_ids;
@@ -1218,6 +1655,9 @@ typedef struct {
 	u32_DynArr type_state__interpolated_regular_prop_ids;
 	// co_track.props that just received new state
 	u32_DynArr type_state__newstate_prop_ids;
+	// newstate props to reset to their confirmed state, excludes predicted
+	// props whose prediction matched
+	u32_DynArr type_state__rollback_prop_ids;
 } CoFilterClient;
 
 typedef struct {
@@ -1445,6 +1885,33 @@ typedef struct {
 	ConMap entity_last_predicted_tick; // Dictionary[int, int] = {}
 	ConMap entity_last_received_tick; // Dictionary[int, int] = {}
 	u32_DynArr predicted_entity_ids; // Array[int] = []
+
+	// Flat lists parallel to 'predicted_entity_ids', rebuilt when filtering.
+	// The props of the entity at index i are [offsets[i], offsets[i+1])
+	ConMap predicted_entity_index; // <entity_id, index>
+	u32_DynArr predicted_xtrap_prop_ids; // predicted, non relative
+	u32_DynArr predicted_xtrap_prop_offsets;
+	u32_DynArr predicted_received_prop_ids; // non relative, not owned
+	u32_DynArr predicted_received_prop_offsets;
+
+	// Array<entity index, min tick>
+	// Min over the latest tick of the entity's received props, mirrored
+	// into 'entity_last_received_tick'
+	WyncXtrap_EntityMinTick *entity_min_ticks;
+	u32 entity_min_ticks_capacity; // entities
+
+	// entities whose received state differs from what we predicted, only
+	// these are rolled back. Rebuilt every time state is received
+	u32_DynArr diverged_entity_ids;
+
+	// ticks below this one were already predicted, predicting them again
+	// is re-simulation
+	i32 cycle_first_new_tick;
+
+	// maximum re-simulated entity ticks per prediction cycle, 0 = unlimited.
+	// Entities that don't fit continue from their confirmed state
+	u32 resim_budget_entity_ticks;
+	u32 resim_budget_used;
 	
 	
 	// --------------------------------------------------------
@@ -1470,10 +1937,29 @@ typedef struct {
 	// MAYBEDO: use ms as magnitud
 	float max_lerp_factor_symmetric;
 
+	// dead reckoning past the right state, 0 = disabled
+	u16 extrapolation_max_ms;
+	u16 extrapolation_correction_ms;
+
+	// (client only) adaptive lerp_ms, evaluated every
+	// LERP_ADAPTIVE_WINDOW_TICKS ticks
+	bool adaptive_enabled;
+	u16 adaptive_min_ms;
+	u16 adaptive_max_ms;
+	float adaptive_underrun_target;
+	u32 adaptive_window_ticks;
+	u32 adaptive_window_underruns;
+	u16 lerp_ms_sent; // last value the server knows about
+
 	// used to (1) lerp and (2) time warp
 	float lerp_delta_accumulator_ms;
 	u32 last_tick_rendered_left;
 	float minimum_lerp_fraction_accumulated_ms;
+
+	// Snapshot timing used by the last precompute, when it changes every
+	// prop's lerp pair is recomputed
+	i32 precomputed_server_tick_offset;
+	float precomputed_delay_ms;
 } CoLerp;
 
 
@@ -1509,6 +1995,27 @@ typedef struct {
 	float snap_tick_delay_mean;
 	u32_RinBuf snap_tick_delay_window;
 
+	// (client only)
+	// ratio [0, 1] of packets lost, estimated from unanswered clock requests
+	float packet_loss;
+	u32 packet_loss_requests_sent;
+	u32 packet_loss_responses_received;
+
+	// (client only)
+	// entity ticks simulated in the last prediction cycle, and how many of
+	// them repeated a tick already predicted (below 'cycle_first_new_tick')
+	u32 xtrap_entity_ticks_simulated;
+	u32 xtrap_entity_ticks_resimulated;
+	// entities that didn't fit the re-simulation budget last cycle
+	u32 xtrap_entities_over_budget;
+	u32 xtrap_predictions_checked;
+	u32 xtrap_mispredictions;
+
+	// (client only)
+	// how many past ticks of inputs are resent every tick, adapts to
+	// 'packet_loss' between INPUT_AMOUNT_TO_SEND_MIN and INPUT_AMOUNT_TO_SEND
+	u32 input_amount_to_send;
+
 	
 	// (client only)
 	// it's described in common.ticks between receiving updates from the server
@@ -1535,6 +2042,7 @@ struct WyncCtx {
 
 	CoThrottling co_throttling;
 	CoFilterServer co_filter_s;
+	CoTimewarp co_timewarp;
 
 	// Client only
 
@@ -1557,6 +2065,9 @@ struct WyncCtx {
 	// --------------------------------------------------------
 	// must be a power of two, 64 ~= 1 second at 60 tps
 	u32 max_tick_history_timewarp;
+	// 0: full history in the state buffer. Otherwise a keyframe every N ticks
+	// and XOR deltas in between, see WyncProp_Timewarp
+	u32 timewarp_keyframe_interval;
 
 	// --------------------------------------------------------
 	// Client Settings